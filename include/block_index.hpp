@@ -0,0 +1,126 @@
+#pragma once
+
+#include "utils.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hexview {
+
+/**
+ * @brief Per-block summary of a file, kept in a sidecar file next to it
+ *
+ * Every INDEX_BLOCK_SIZE bytes of the file get one 16-byte entry: an XXH64
+ * hash, flags for blocks of zeros, of 0xFF bytes or of one repeated value,
+ * the entropy (in 1/32 bits per byte) and the share of text bytes (in
+ * 1/255). The sidecar starts with a header holding the block size and the
+ * size, modification time, inode and device of the file it describes; an
+ * index whose header does not match the file is rebuilt. Building reads
+ * the file once with pread() on a thread pool.
+ */
+class BlockIndex {
+public:
+    /**
+     * @brief Summary of one block
+     */
+    struct Entry {
+        std::uint64_t hash = 0;             // XXH64 of the block
+        std::uint8_t flags = 0;             // ZERO, ONES and UNIFORM
+        std::uint8_t value = 0;             // the repeated byte of a UNIFORM block
+        std::uint8_t entropy = 0;           // bits per byte times 32, at most 255
+        std::uint8_t text = 0;              // share of text bytes times 255
+        std::uint32_t reserved = 0;
+    };
+
+    static constexpr std::uint8_t ZERO = 1;     // every byte is 0x00
+    static constexpr std::uint8_t ONES = 2;     // every byte is 0xFF
+    static constexpr std::uint8_t UNIFORM = 4;  // every byte is value
+
+    /**
+     * @brief A run of whole dump lines whose bytes all have one value
+     */
+    struct UniformLines {
+        ByteRange lines;                    // empty at the end of the range when there is none
+        std::uint8_t value = 0;
+    };
+
+    /**
+     * @brief Sidecar path used for a file (the file name plus ".hvidx")
+     */
+    static std::string sidecar_path(const std::string& filename);
+
+    /**
+     * @brief Load an up-to-date index, building and saving it if needed
+     *
+     * A sidecar that cannot be written only costs a warning; the index
+     * built in memory is still used.
+     * @param filename Indexed file (a regular file)
+     * @param path Sidecar file
+     * @param allow_build Whether to build a missing or stale index (otherwise fail quietly)
+     * @param threads Threads used to build the index
+     * @return true if the index is ready
+     */
+    bool open(const std::string& filename, const std::string& path, bool allow_build, std::size_t threads);
+
+    std::uint64_t block_size() const { return block_size_; }
+    std::uint64_t file_size() const { return file_size_; }
+    const std::vector<Entry>& entries() const { return entries_; }
+
+    /**
+     * @brief First block boundary at or after an offset whose block is not uniform
+     * @param offset Offset to start from
+     * @return Offset of that block (clamped to offset), or the file size when there is none
+     */
+    std::uint64_t next_data(std::uint64_t offset) const;
+
+    /**
+     * @brief Find the next whole lines that lie inside blocks of one repeated value
+     *
+     * Lines start at from and every bytes_per_line after; runs shorter than
+     * two lines are ignored.
+     * @param from First byte to look at
+     * @param end First byte past the dumped range
+     * @param bytes_per_line Line size
+     * @return Lines of the next run, or an empty range at end when there is none
+     */
+    UniformLines find_uniform_lines(std::uint64_t from, std::uint64_t end, std::size_t bytes_per_line) const;
+
+private:
+    /**
+     * @brief What an index must match to describe a file
+     */
+    struct FileIdentity {
+        std::uint64_t size = 0;
+        std::uint64_t mtime_sec = 0;
+        std::uint64_t mtime_nsec = 0;
+        std::uint64_t inode = 0;
+        std::uint64_t device = 0;
+    };
+
+    std::uint64_t block_size_ = 0;
+    std::uint64_t file_size_ = 0;
+    std::vector<Entry> entries_;
+
+    /**
+     * @brief Whether two blocks hold one and the same repeated byte
+     */
+    static bool same_fill(const Entry& a, const Entry& b);
+
+    /**
+     * @brief Read the entries of a sidecar that matches the file
+     */
+    bool load(const std::string& path, const FileIdentity& identity);
+
+    /**
+     * @brief Summarize every block of the file
+     */
+    bool build(int fd, std::size_t threads);
+
+    /**
+     * @brief Write the sidecar (through a temporary file renamed over it)
+     */
+    bool save(const std::string& path, const FileIdentity& identity) const;
+};
+
+} // namespace hexview
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "io_ring.hpp"
+#include "utils.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hexview {
+
+/**
+ * @brief Sequential reader that keeps several block reads in flight
+ *
+ * The range is read in fixed-size blocks into a ring of buffers so the
+ * caller formats one block while the following ones are being read.
+ * Reads go through io_uring, into registered buffers when the kernel allows
+ * it; without io_uring a helper thread reads ahead with pread(). Blocks that
+ * lie wholly inside a hole of a sparse file are not read at all.
+ */
+class BlockReader {
+public:
+    BlockReader() = default;
+
+    /**
+     * @brief Wait for outstanding reads, free the buffers and close the file
+     */
+    ~BlockReader();
+
+    BlockReader(const BlockReader&) = delete;
+    BlockReader& operator=(const BlockReader&) = delete;
+
+    /**
+     * @brief Open a file and start reading ahead
+     * @param path File to open
+     * @param start First byte to read
+     * @param length Number of bytes to read (0 = to the end)
+     * @param block_size Size of each block
+     * @param depth Number of blocks in flight (at least 2)
+     * @return false if the file is not seekable and should be streamed instead
+     */
+    bool open(const std::string& path, std::uint64_t start, std::uint64_t length,
+              std::size_t block_size, std::size_t depth);
+
+    /**
+     * @brief Get the next block in file order
+     *
+     * The returned bytes stay valid until the next call. Every block is
+     * block_size bytes except the last one.
+     * @return Next block, empty at the end of the range or on error
+     */
+    std::span<const std::byte> next();
+
+    /**
+     * @brief errno of the read that stopped the reader, 0 if none failed
+     */
+    int error() const { return error_; }
+
+    /**
+     * @brief File offset just past the last block handed out
+     */
+    std::uint64_t position() const { return position_; }
+
+    /**
+     * @brief Descriptor of the open file, e.g. to look for holes
+     */
+    int fd() const { return fd_; }
+
+    /**
+     * @brief End of the range being read
+     */
+    std::uint64_t end() const { return end_; }
+
+private:
+    struct Slot {
+        std::uint64_t offset = 0;   // file offset of the block
+        std::size_t size = 0;       // bytes requested
+        std::size_t filled = 0;     // bytes read so far
+        int error = 0;              // errno of a failed read
+        bool hole = false;          // inside a hole, reads as zeros_
+        bool done = false;          // read finished (guarded by mutex_ for the pread thread)
+    };
+
+    int fd_ = -1;
+    std::uint64_t start_ = 0;
+    std::uint64_t end_ = 0;
+    std::uint64_t position_ = 0;
+    std::size_t block_size_ = 0;
+    std::uint64_t blocks_ = 0;      // blocks in the range
+    std::uint64_t queued_ = 0;      // blocks whose read has been issued
+    std::uint64_t next_block_ = 0;  // block next() hands out next
+    bool held_ = false;             // the caller holds block next_block_
+    bool stopped_ = false;
+    int error_ = 0;
+
+    std::byte* buffers_ = nullptr;
+    std::size_t buffers_size_ = 0;
+    const std::byte* zeros_ = nullptr;  // untouched block past the slots
+    ByteRange hole_{};              // hole of the file at or after the last block queued
+    std::vector<Slot> slots_;
+
+    IoRing ring_;
+    bool use_ring_ = false;
+    unsigned in_flight_ = 0;
+
+    std::thread reader_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    bool stopping_ = false;
+
+    std::byte* slot_data(std::size_t index) const { return buffers_ + index * block_size_; }
+
+    /**
+     * @brief Whether a block lies wholly inside a hole of the file
+     *
+     * Called for blocks in file order by whichever side issues the reads.
+     */
+    bool in_hole(std::uint64_t offset, std::size_t size);
+
+    /**
+     * @brief Issue the read of the next queued block through the ring
+     */
+    void queue_block();
+
+    /**
+     * @brief Reap ring completions until the slot's read has finished
+     * @param slot Slot to wait for
+     * @return false if the ring failed
+     */
+    bool wait_ring(Slot& slot);
+
+    /**
+     * @brief pread() read-ahead loop of the helper thread
+     */
+    void read_ahead();
+};
+
+} // namespace hexview
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "options.hpp"
+#include "output_sink.hpp"
+#include "simd_kernels.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace hexview {
+
+/**
+ * @brief Renders the plain (-p) and C include (-i) output styles
+ *
+ * These styles have no offset or ASCII column, so rows are encoded in
+ * batches straight into the sink's buffer: plain rows with the vectorized
+ * encode_hex kernel, C array rows from a table of pre-rendered "0xHH, "
+ * literals written with one 64-bit store per byte. The Formatter is not
+ * involved.
+ */
+class BulkEncoder {
+public:
+    /**
+     * @brief Construct an encoder
+     * @param options Configuration options (style, bytes_per_line, uppercase, filename)
+     * @param sink Destination for the encoded rows
+     */
+    BulkEncoder(const Options& options, OutputSink& sink);
+
+    /**
+     * @brief Encode whole rows
+     * @param data Input bytes, a multiple of bytes_per_line
+     */
+    void encode_rows(std::span<const std::byte> data);
+
+    /**
+     * @brief Encode the last partial row and close the output
+     *
+     * For -i this ends the array and adds the length symbol; called once
+     * at the end of the input.
+     * @param partial Bytes of the final partial row (may be empty)
+     */
+    void finish(std::span<const std::byte> partial);
+
+private:
+    const Options& options_;
+    OutputSink& sink_;
+    const HexKernels& kernels_;
+    const char* c_bytes_;           // CByteTable for the requested letter case
+    std::string name_;              // C identifier of the array, empty for stdin
+    std::size_t row_size_;          // upper bound on the characters of one row
+    std::uint64_t total_ = 0;       // bytes encoded so far
+    bool started_ = false;
+
+    /**
+     * @brief Write the array declaration before the first row (-i only)
+     */
+    void begin();
+
+    /**
+     * @brief Encode one row
+     * @param bytes Row bytes
+     * @param count Number of bytes (at most bytes_per_line)
+     * @param out Destination with room for row_size_ characters
+     * @return Pointer one past the last character written
+     */
+    char* render_row(const unsigned char* bytes, std::size_t count, char* out);
+};
+
+} // namespace hexview
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Block checksums for --checksum: CRC-32C and XXH64 with runtime dispatch
+namespace hexview {
+
+/**
+ * @brief CRC-32C (Castagnoli polynomial, as used by iSCSI, ext4 and btrfs)
+ *
+ * Uses the SSE4.2 crc32 instruction when the CPU has it and HEXVIEW_SIMD
+ * does not ask for scalar kernels. The instruction has a latency of three
+ * cycles but a throughput of one per cycle, so long buffers are split into
+ * three streams hashed side by side and joined with precomputed shift
+ * tables. Other CPUs use slicing-by-8 tables.
+ * @param in Bytes to hash
+ * @param count Number of bytes
+ * @return Checksum of the bytes
+ */
+std::uint32_t crc32c(const unsigned char* in, std::size_t count);
+
+/**
+ * @brief Whether crc32c() uses the crc32 instruction
+ */
+bool crc32c_hardware();
+
+/**
+ * @brief XXH64 hash of a buffer
+ *
+ * Input is consumed 32 bytes at a time by four independent accumulators,
+ * so the multiplies of one stripe overlap with those of the next.
+ * @param in Bytes to hash
+ * @param count Number of bytes
+ * @param seed Hash seed
+ * @return XXH64 of the bytes (the canonical value, as printed by xxhsum)
+ */
+std::uint64_t xxh64(const unsigned char* in, std::size_t count, std::uint64_t seed = 0);
+
+} // namespace hexview
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "options.hpp"
+#include "formatter.hpp"
+#include "output_sink.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace hexview {
+
+/**
+ * @brief Block checksums of an input (--checksum), listed or next to the dump
+ *
+ * The input is split into blocks of checksum_block bytes counted from the
+ * start offset. By default each block becomes one line with its offset and
+ * checksum; with --annotate the input is dumped and each block's checksum
+ * is appended to the line that ends it. The calling thread reads chunks of
+ * whole blocks and renders them while a thread pool hashes the chunks read
+ * ahead of it, so hashing overlaps with reading and formatting.
+ */
+class ChecksumDumper {
+public:
+    /**
+     * @brief Construct a dumper
+     * @param options Configuration options (checksum, checksum_block, annotate)
+     * @param formatter Formatter used to render offsets and dump lines
+     * @param sink Destination of the output
+     */
+    ChecksumDumper(const Options& options, const Formatter& formatter, OutputSink& sink);
+
+    /**
+     * @brief Read an input to its end and write the checksums
+     * @param fd Input file descriptor (positioned at its beginning)
+     * @return 0 for success, error code otherwise
+     */
+    int run(int fd);
+
+private:
+    /**
+     * @brief One chunk of input on its way through the hashing workers
+     */
+    struct ChunkSlot {
+        std::uint64_t offset = 0;           // first byte of the chunk
+        std::vector<std::byte> input;
+        std::size_t size = 0;               // bytes read into input
+        std::vector<std::uint64_t> hashes;  // one per block, the last one may be short
+    };
+
+    const Options& options_;
+    const Formatter& formatter_;
+    OutputSink& sink_;
+    std::size_t chunk_size_;                // whole blocks read and hashed at once
+    std::size_t digits_;                    // hex digits of one checksum
+
+    /**
+     * @brief Hash every block of a chunk (runs on a worker thread)
+     */
+    void hash_chunk(ChunkSlot& slot) const;
+
+    /**
+     * @brief Render the hex digits of a checksum
+     * @return Pointer one past the last digit
+     */
+    char* render_hash(std::uint64_t hash, char* out) const;
+
+    /**
+     * @brief Write one line per block of a hashed chunk
+     */
+    void write_list(const ChunkSlot& slot);
+
+    /**
+     * @brief Dump a hashed chunk with the checksums after the lines that end blocks
+     */
+    void write_annotated(const ChunkSlot& slot);
+};
+
+} // namespace hexview
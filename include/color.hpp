@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <string_view>
 
 namespace hexview {
 
@@ -14,6 +15,9 @@ public:
         BrightYellow,
         BrightGreen,
         BrightWhite,
+        BrightRed,
+        BrightBlue,
+        BrightCyan,
     };
 
     /**
@@ -33,6 +37,13 @@ public:
      */
     void reset() const;
 
+    /**
+     * @brief Get the escape sequence for a color code
+     * @param code Color code to look up
+     * @return Escape sequence, or an empty view when color is disabled
+     */
+    std::string_view sequence(Code code) const;
+
 private:
     bool enabled_;
 };
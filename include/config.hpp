@@ -7,6 +7,9 @@ namespace hexview {
 
 constexpr char const* VERSION = "Hexview 1.0";
 constexpr size_t DEFAULT_BYTES_PER_LINE = 16;
+constexpr size_t DEFAULT_PLAIN_BYTES_PER_LINE = 30;     // -p rows, as xxd -p
+constexpr size_t DEFAULT_INCLUDE_BYTES_PER_LINE = 12;   // -i rows, as xxd -i
+constexpr size_t DEFAULT_BITS_BYTES_PER_LINE = 6;       // -b lines, as xxd -b
 constexpr size_t DEFAULT_GROUP_SIZE = 1;
 constexpr size_t DEFAULT_OFFSET_WIDTH = 8;
 
@@ -15,10 +18,69 @@ constexpr size_t MIN_READ_BLOCK_SIZE = 4096;        // 4KB minimum
 constexpr size_t MAX_READ_BLOCK_SIZE = 1048576;     // 1MB maximum
 constexpr size_t DEFAULT_READ_BLOCK_SIZE = 65536;   // 64KB default
 
+// Output buffering: flushes are sized to the destination but kept within these bounds
+constexpr size_t MIN_OUTPUT_BLOCK_SIZE = 65536;     // 64KB minimum
+constexpr size_t MAX_OUTPUT_BLOCK_SIZE = 4194304;   // 4MB maximum
+
 // Large file support thresholds
 constexpr size_t LARGE_FILE_THRESHOLD = 2147483648ULL;  // 2GB
 constexpr size_t HUGE_FILE_THRESHOLD = 107374182400ULL; // 100GB
 
+// Memory-mapped input: ranges above LARGE_FILE_THRESHOLD are mapped in
+// sliding windows aligned to the 2MB huge page size
+constexpr size_t HUGE_PAGE_SIZE = 2097152;              // 2MB
+constexpr size_t LARGE_FILE_MAP_WINDOW = 268435456;     // 256MB windows above LARGE_FILE_THRESHOLD
+constexpr size_t HUGE_FILE_MAP_WINDOW = 1073741824;     // 1GB windows above HUGE_FILE_THRESHOLD
+
+// Parallel dumping: input is split into chunks of about this many bytes
+// (rounded down to whole lines) and each worker may have a few chunks in flight
+constexpr size_t PARALLEL_CHUNK_SIZE = 1048576;         // 1MB per chunk
+constexpr size_t REORDER_SLOTS_PER_THREAD = 2;          // reorder buffer depth per worker
+
+// Read-ahead (--queue-depth): blocks of about this size (rounded down to whole
+// lines) are kept in flight through io_uring or a pread() helper thread
+constexpr size_t READ_AHEAD_BLOCK_SIZE = 1048576;       // 1MB per block
+constexpr size_t MAX_READ_QUEUE_DEPTH = 64;             // upper bound on blocks in flight
+
+// Reader/formatter/writer pipeline (--pipeline): each stage pair shares a
+// fixed pool of buffers that is recycled for the whole run
+constexpr size_t PIPELINE_BLOCK_SIZE = 262144;          // 256KB input blocks
+constexpr size_t PIPELINE_BUFFERS = 8;                  // buffers per pool (a power of two)
+
+// Reverse mode (-r): dump text is read and decoded bytes are written in blocks of this size
+constexpr size_t REVERSE_BLOCK_SIZE = 1048576;          // 1MB
+
+// Diff mode (--diff): both inputs are compared in blocks of about this size
+// (rounded down to whole lines)
+constexpr size_t DIFF_BLOCK_SIZE = 4194304;             // 4MB
+
+// Search mode (--find): the input is read and scanned in blocks of this size
+constexpr size_t FIND_BLOCK_SIZE = 1048576;             // 1MB
+
+// Signature scan (--signatures): chunk scanned by one worker, or read block of streamed inputs
+constexpr size_t SIGNATURE_CHUNK_SIZE = 4194304;        // 4MB
+
+// Strings mode (--strings): shortest string listed by default, and read block size
+constexpr size_t DEFAULT_STRINGS_MIN = 4;
+constexpr size_t STRINGS_BLOCK_SIZE = 1048576;          // 1MB
+
+// Entropy mode (--entropy): whole blocks summarized by one worker, or read at once when streamed
+constexpr size_t ENTROPY_CHUNK_SIZE = 4194304;          // 4MB
+constexpr double RANDOM_ENTROPY = 7.2;                  // bits per byte of compressed or encrypted data
+constexpr size_t TEXT_PERCENT = 90;                     // share of text bytes (printable, tab, CR, LF) in text
+
+// Checksum mode (--checksum): default block size, and whole blocks read and hashed at once
+constexpr size_t DEFAULT_CHECKSUM_BLOCK = 4096;
+constexpr size_t CHECKSUM_CHUNK_SIZE = 1048576;         // 1MB
+
+// Block index (--index): bytes summarized per entry, and blocks read by one worker at a time
+constexpr size_t INDEX_BLOCK_SIZE = 65536;              // 64KB
+constexpr size_t INDEX_CHUNK_BLOCKS = 64;               // 4MB
+
+// Interactive pager (--interactive): rendered screens kept, and bytes read per search step
+constexpr size_t PAGER_CACHE_PAGES = 16;
+constexpr size_t PAGER_SEARCH_CHUNK_SIZE = 4194304;     // 4MB
+
 // Calculate optimal buffer size based on bytes per line
 constexpr size_t calculate_optimal_buffer_size(size_t bytes_per_line) {
     // Target ~256 lines worth of data, but within reasonable bounds
@@ -28,4 +90,13 @@ constexpr size_t calculate_optimal_buffer_size(size_t bytes_per_line) {
     return target;
 }
 
+// Calculate output buffer size from the destination's preferred I/O size
+constexpr size_t calculate_output_buffer_size(size_t preferred) {
+    if (preferred == 0) return MIN_OUTPUT_BLOCK_SIZE;
+    if (preferred > MAX_OUTPUT_BLOCK_SIZE) return MAX_OUTPUT_BLOCK_SIZE;
+    // Round up to a whole number of preferred blocks
+    size_t blocks = (MIN_OUTPUT_BLOCK_SIZE + preferred - 1) / preferred;
+    return blocks * preferred;
+}
+
 } // namespace hexview
\ No newline at end of file
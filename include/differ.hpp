@@ -0,0 +1,128 @@
+#pragma once
+
+#include "options.hpp"
+#include "formatter.hpp"
+#include "mapped_input.hpp"
+#include "output_sink.hpp"
+#include "simd_kernels.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hexview {
+
+/**
+ * @brief One input of a diff, delivered in consecutive fixed-size blocks
+ *
+ * Regular files and block devices are served straight from a memory
+ * mapping; pipes and other inputs are read into a buffer.
+ */
+class DiffInput {
+public:
+    DiffInput() = default;
+
+    /**
+     * @brief Close the input (if it is not stdin)
+     */
+    ~DiffInput();
+
+    DiffInput(const DiffInput&) = delete;
+    DiffInput& operator=(const DiffInput&) = delete;
+
+    /**
+     * @brief Open an input and position it at the start offset
+     * @param path File to open, "-" for stdin
+     * @param start First byte to compare
+     * @param length Number of bytes to compare (0 = to the end)
+     * @param block_size Size of the blocks next() returns
+     * @return false if the input cannot be opened (errno is set)
+     */
+    bool open(const std::string& path, std::uint64_t start, std::uint64_t length, std::size_t block_size);
+
+    /**
+     * @brief Get the next block
+     * @return block_size bytes, fewer at the end of the input, empty past it or on error
+     */
+    std::span<const std::byte> next();
+
+    /**
+     * @brief errno of a failed read or mapping, 0 if none
+     */
+    int error() const { return error_; }
+
+private:
+    MappedInput mapped_;
+    bool use_map_ = false;
+    std::span<const std::byte> window_;     // current mapping (mapped inputs)
+    std::uint64_t window_offset_ = 0;       // offset of window_[0]
+    std::uint64_t offset_ = 0;              // offset of the next block
+    std::uint64_t end_ = 0;                 // first offset past the range (mapped inputs)
+
+    int fd_ = -1;                           // streamed inputs
+    bool owns_fd_ = false;
+    std::uint64_t remaining_ = 0;           // bytes left to read (streamed inputs with a length)
+    bool limited_ = false;
+    std::vector<std::byte> buffer_;
+    std::size_t block_size_ = 0;
+    int error_ = 0;
+};
+
+/**
+ * @brief Shows the lines where two inputs differ (--diff)
+ *
+ * Both inputs are compared block by block with the vectorized mismatch
+ * kernel, so identical stretches cost one pass over memory. Each
+ * differing line is rendered for both inputs with the Formatter, so
+ * offsets and grouping match a normal dump, either interleaved ("-" and
+ * "+" prefixes) or side by side; differing bytes are highlighted when
+ * color is enabled. Runs of identical lines are summarized by a single
+ * marker line.
+ */
+class Differ {
+public:
+    /**
+     * @brief Construct a differ
+     * @param options Configuration options (filename and diff_filename are compared)
+     * @param formatter Formatter used to render lines and markers
+     * @param sink Destination of the rendered lines
+     */
+    Differ(const Options& options, const Formatter& formatter, OutputSink& sink);
+
+    /**
+     * @brief Compare the inputs and write the differing lines
+     * @return 0 if the inputs are identical, 1 if they differ, 2 on errors
+     */
+    int run();
+
+private:
+    const Options& options_;
+    const Formatter& formatter_;
+    OutputSink& sink_;
+    const HexKernels& kernels_;
+    std::uint64_t same_from_ = 0;           // first line not yet shown or summarized
+    std::vector<std::uint8_t> marks_;       // highlight flags of the line pair being rendered
+
+    /**
+     * @brief Summarize the identical lines from same_from_ up to an offset
+     * @param end Offset of the first line that is not identical
+     */
+    void emit_identical(std::uint64_t end);
+
+    /**
+     * @brief Render a differing line of both inputs
+     * @param a Line of the first input
+     * @param b Line of the second input
+     * @param offset Offset of the line
+     */
+    void emit_lines(std::span<const std::byte> a, std::span<const std::byte> b, std::uint64_t offset);
+
+    /**
+     * @brief Render a marker line
+     */
+    void emit_marker(std::string_view label, std::uint64_t begin, std::uint64_t end);
+};
+
+} // namespace hexview
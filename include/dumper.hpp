@@ -3,7 +3,15 @@
 #include "options.hpp"
 #include "formatter.hpp"
 #include "color.hpp"
+#include "mapped_input.hpp"
+#include "block_reader.hpp"
+#include "bulk_encoder.hpp"
+#include "line_squeezer.hpp"
+#include "output_sink.hpp"
+#include "block_index.hpp"
+#include <cstddef>
 #include <memory>
+#include <span>
 
 namespace hexview {
 
@@ -18,6 +26,14 @@ public:
      */
     explicit HexDumper(const Options& options);
 
+    /**
+     * @brief Close the output file, if any
+     */
+    ~HexDumper();
+
+    HexDumper(const HexDumper&) = delete;
+    HexDumper& operator=(const HexDumper&) = delete;
+
     /**
      * @brief Run the hex dump process
      * @return Exit code (0 for success)
@@ -27,7 +43,13 @@ public:
 private:
     Options options_;
     std::unique_ptr<Color> color_;
+    std::unique_ptr<OutputSink> sink_;
     std::unique_ptr<Formatter> formatter_;
+    std::unique_ptr<LineSqueezer> squeezer_;    // null when repeated lines are shown (-v)
+    std::unique_ptr<BulkEncoder> encoder_;      // plain (-p) and C include (-i) styles, null for dumps
+    std::unique_ptr<BlockIndex> index_;         // block index of the input file, null when none is used
+    int output_fd_ = -1;                    // --output file, -1 when writing to stdout
+    int output_error_ = 0;                  // errno of a failed --output open
 
     /**
      * @brief Setup input stream (file or stdin)
@@ -35,11 +57,136 @@ private:
      */
     int setup_input();
 
+    /**
+     * @brief Open the input (stdin for "-", switched to binary mode on Windows)
+     * @return File descriptor, or -1 after reporting the error
+     */
+    int open_input() const;
+
+    /**
+     * @brief Close an input returned by open_input() (stdin stays open)
+     */
+    void close_input(int fd) const;
+
     /**
      * @brief Process input and generate hex dump
      * @return 0 for success, error code otherwise
      */
     int process_input();
+
+    /**
+     * @brief Generate hex dump directly from a memory-mapped file
+     * @param input Opened mapping covering the requested range
+     * @return 0 for success, error code otherwise
+     */
+    int process_mapped(MappedInput& input);
+
+    /**
+     * @brief Generate hex dump from blocks read ahead of the formatter
+     * @param reader Opened reader covering the requested range
+     * @return 0 for success, error code otherwise
+     */
+    int process_blocks(BlockReader& reader);
+
+    /**
+     * @brief Generate hex dump through the reader/formatter/writer pipeline
+     * @return 0 for success, error code otherwise
+     */
+    int process_pipeline();
+
+    /**
+     * @brief Turn a dump back into binary (-r)
+     * @return 0 for success, error code otherwise
+     */
+    int process_reverse();
+
+    /**
+     * @brief Show the lines where two inputs differ (--diff)
+     * @return 0 if the inputs are identical, 1 if they differ, 2 on errors
+     */
+    int process_diff();
+
+    /**
+     * @brief Dump only the lines holding a pattern (--find)
+     * @return 0 if the pattern was found, 1 if not, 2 on errors
+     */
+    int process_find();
+
+    /**
+     * @brief List every occurrence of a set of signatures (--signatures)
+     * @return 0 if a signature was found, 1 if not, 2 on errors
+     */
+    int process_signatures();
+
+    /**
+     * @brief List the printable strings of the input (--strings)
+     * @return 0 for success, error code otherwise
+     */
+    int process_strings();
+
+    /**
+     * @brief Summarize the entropy of every block of the input (--entropy)
+     * @return 0 for success, error code otherwise
+     */
+    int process_entropy();
+
+    /**
+     * @brief List the checksum of every block, or dump with them (--checksum)
+     * @return 0 for success, error code otherwise
+     */
+    int process_checksum();
+
+    /**
+     * @brief Load the block index of the input file into index_
+     *
+     * --index, --summary and --next-data build a missing or stale index;
+     * otherwise only files above HUGE_FILE_THRESHOLD look for an index,
+     * and only one that is up to date is used.
+     * @param allow_build Whether to build a missing or stale index (and report failures)
+     * @return true if the index is loaded
+     */
+    bool load_index(bool allow_build);
+
+    /**
+     * @brief List runs of similar blocks from the block index (--summary)
+     * @return 0 for success, error code otherwise
+     */
+    int process_summary();
+
+    /**
+     * @brief Browse the input in a full-screen pager (--interactive)
+     * @return 0 for success, error code otherwise
+     */
+    int process_interactive();
+
+    /**
+     * @brief Format every whole line in a block of input
+     * @param data Block of input bytes
+     * @param offset Offset of the first byte of the block
+     * @return Number of bytes consumed (a multiple of bytes_per_line)
+     */
+    std::size_t format_lines(std::span<const std::byte> data, std::uint64_t offset);
+
+    /**
+     * @brief Format the end of the range
+     *
+     * Renders the partial line that ends the range, if any, and the last
+     * line of a squeezed run the input ended in.
+     * @param partial Bytes of the final partial line (may be empty)
+     * @param offset Offset of the first byte of partial
+     */
+    void format_final_line(std::span<const std::byte> partial, std::uint64_t offset);
+
+    /**
+     * @brief Whether --output names a regular file that can be written at any position
+     */
+    bool output_is_regular_file() const;
+
+    /**
+     * @brief Flush formatted output and report write errors
+     * @return 0 for success, error code otherwise
+     */
+    int finish_output();
 };
 
 } // namespace hexview
\ No newline at end of file
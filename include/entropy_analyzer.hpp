@@ -0,0 +1,133 @@
+#pragma once
+
+#include "options.hpp"
+#include "color.hpp"
+#include "formatter.hpp"
+#include "output_sink.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace hexview {
+
+/**
+ * @brief Number of occurrences of every byte value
+ */
+using ByteHistogram = std::array<std::uint64_t, 256>;
+
+/**
+ * @brief Add the byte counts of a buffer to a histogram
+ *
+ * Consecutive bytes go to four different tables, so a run of equal bytes
+ * increments four counters in turn instead of making every increment wait
+ * for the store of the one before it.
+ */
+void count_bytes(const unsigned char* in, std::size_t count, ByteHistogram& histogram);
+
+/**
+ * @brief Number of text bytes (printable ASCII, tab, CR and LF) in a histogram
+ */
+std::uint64_t count_text(const ByteHistogram& histogram);
+
+/**
+ * @brief Shannon entropy of a histogram in bits per byte
+ *
+ * A histogram with at most one byte value is exactly 0.
+ * @param histogram Byte counts
+ * @param total Sum of the counts
+ * @param xlogx Precomputed c * log2(c) for the counts below its size (may be empty)
+ */
+double histogram_entropy(const ByteHistogram& histogram, std::uint64_t total, std::span<const double> xlogx = {});
+
+/**
+ * @brief Per-block byte histogram and Shannon entropy summary (--entropy)
+ *
+ * Each block of the input becomes one line: its offset, its entropy in
+ * bits per byte with a bar colored on a blue (ordered) to red (random)
+ * scale, the share of text bytes and a rough class (zero, fill, text,
+ * data, random). Histograms are counted into four interleaved tables so
+ * runs of equal bytes do not serialize on one counter. Seekable inputs are
+ * split into chunks of whole blocks that a thread pool reads with pread()
+ * and summarizes; the lines are written in offset order.
+ */
+class EntropyAnalyzer {
+public:
+    /**
+     * @brief Construct an analyzer
+     * @param options Configuration options (entropy gives the block size)
+     * @param formatter Formatter used to render the offsets
+     * @param color Colors of the entropy scale
+     * @param sink Destination of the summary lines
+     */
+    EntropyAnalyzer(const Options& options, const Formatter& formatter, const Color& color, OutputSink& sink);
+
+    /**
+     * @brief Summarize the input and write one line per block
+     * @param fd Open input, positioned at its beginning
+     * @return 0 for success, error code otherwise
+     */
+    int run(int fd);
+
+private:
+    /**
+     * @brief One chunk of a parallel run
+     */
+    struct ChunkSlot {
+        std::uint64_t offset = 0;           // first byte of the chunk
+        std::size_t length = 0;             // bytes requested, then bytes read
+        std::vector<std::byte> input;       // bytes read with pread()
+        std::vector<char> output;           // summary lines
+        std::size_t output_size = 0;        // characters used in output
+        int error = 0;                      // errno of a failed read
+    };
+
+    const Options& options_;
+    const Formatter& formatter_;
+    OutputSink& sink_;
+    std::array<std::string_view, 5> scale_; // bar colors from low to high entropy
+    std::string_view reset_;
+    std::size_t line_size_;                 // upper bound of one summary line
+    std::size_t chunk_size_;                // whole blocks read and summarized at once
+    std::vector<double> xlogx_;             // c * log2(c) for every count of a small block
+
+    /**
+     * @brief Render the summary lines of consecutive blocks
+     * @param data Whole blocks (the last one may be short)
+     * @param offset Offset of data[0]
+     * @param out Destination with room for one line_size_ per block
+     * @return Pointer one past the last character written
+     */
+    char* summarize(std::span<const std::byte> data, std::uint64_t offset, char* out) const;
+
+    /**
+     * @brief Render the summary line of one block
+     */
+    char* summarize_block(const unsigned char* data, std::size_t size, std::uint64_t offset, char* out) const;
+
+    /**
+     * @brief Read and summarize one chunk (runs on a worker thread)
+     * @param fd Open input
+     * @param slot Chunk to fill; offset and length are set by the caller
+     */
+    void summarize_chunk(int fd, ChunkSlot& slot) const;
+
+    /**
+     * @brief Summarize a seekable input in chunks on a thread pool
+     * @param fd Open input
+     * @param end First byte past the summarized range
+     * @return 0 for success, error code otherwise
+     */
+    int run_parallel(int fd, std::uint64_t end);
+
+    /**
+     * @brief Summarize an input read block by block
+     * @param fd Input positioned at its beginning
+     * @return 0 for success, error code otherwise
+     */
+    int run_streamed(int fd);
+};
+
+} // namespace hexview
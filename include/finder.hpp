@@ -0,0 +1,119 @@
+#pragma once
+
+#include "options.hpp"
+#include "formatter.hpp"
+#include "output_sink.hpp"
+#include "simd_kernels.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string_view>
+#include <vector>
+
+namespace hexview {
+
+/**
+ * @brief Byte pattern of --find, with optional wildcards
+ *
+ * A pattern byte p matches an input byte c when (c & mask) == value, so
+ * mask 0xFF is an exact byte, 0x00 any byte and 0xF0 / 0x0F a byte with
+ * one fixed nibble.
+ */
+struct SearchPattern {
+    std::vector<unsigned char> value;       // expected bits of every byte
+    std::vector<unsigned char> mask;        // bits of every byte that must match
+
+    /**
+     * @brief Parse a hex pattern ("de ad ?? ef", "0xdeadbeef", "4?")
+     *
+     * Whitespace and 0x prefixes are ignored; "?" stands for one nibble.
+     * @throws std::invalid_argument if the pattern is malformed
+     */
+    static SearchPattern from_hex(std::string_view text);
+
+    /**
+     * @brief Parse a text pattern ("GIF8?a")
+     *
+     * "?" matches any byte; \?, \\, \n, \r, \t and \xHH are escapes.
+     * @throws std::invalid_argument if the pattern is malformed
+     */
+    static SearchPattern from_text(std::string_view text);
+};
+
+/**
+ * @brief Dumps only the lines holding a pattern (--find)
+ *
+ * The input is read in blocks; the tail of each block that a match or a
+ * context line may still need is carried to the front of the buffer, so
+ * matches spanning blocks are found. Candidate positions come from the
+ * vectorized pair filter on the first and last fixed bytes of the pattern,
+ * each candidate is verified back to front and the next start is advanced
+ * with a Horspool shift. Matching lines, with context lines around them,
+ * are rendered with the Formatter and the matched bytes highlighted.
+ */
+class Finder {
+public:
+    /**
+     * @brief Construct a finder
+     * @param options Configuration options (find, find_text, context)
+     * @param formatter Formatter used to render lines
+     * @param sink Destination of the rendered lines
+     * @throws std::invalid_argument if the pattern is malformed
+     */
+    Finder(const Options& options, const Formatter& formatter, OutputSink& sink);
+
+    /**
+     * @brief Search an input and write the matching lines
+     * @param fd Input file descriptor (positioned at its beginning)
+     * @return 0 if the pattern was found, 1 if not, 2 on errors
+     */
+    int run(int fd);
+
+private:
+    struct Match {
+        std::uint64_t begin;
+        std::uint64_t end;
+    };
+
+    const Options& options_;
+    const Formatter& formatter_;
+    OutputSink& sink_;
+    const HexKernels& kernels_;
+    SearchPattern pattern_;
+    std::size_t first_ = 0;                 // first pattern byte without wildcards (filter anchor)
+    std::size_t last_ = 0;                  // last pattern byte without wildcards (filter anchor)
+    std::array<std::size_t, 256> shift_{};  // Horspool shift by the byte under the pattern's end
+
+    std::vector<std::byte> buffer_;
+    std::uint64_t buffer_offset_ = 0;       // offset of buffer_[0]
+    std::deque<Match> matches_;             // matches that may still touch unprinted lines
+    std::vector<std::uint8_t> marks_;       // highlight flags of the line being rendered
+    std::uint64_t printed_ = 0;             // next line of the current group to print
+    std::uint64_t print_end_ = 0;           // end of the current group (last line plus context)
+    bool printed_any_ = false;
+
+    /**
+     * @brief Start offset of the line holding an offset
+     */
+    std::uint64_t line_of(std::uint64_t offset) const;
+
+    /**
+     * @brief Check the pattern at a buffer position
+     */
+    bool matches_at(const unsigned char* p) const;
+
+    /**
+     * @brief Record a match and print the lines it makes final
+     */
+    void add_match(std::uint64_t begin);
+
+    /**
+     * @brief Print the lines of the current group before an offset
+     * @param until First offset not to print
+     * @param end End of the input, so the last line may be partial
+     */
+    void print_until(std::uint64_t until, std::uint64_t end);
+};
+
+} // namespace hexview
@@ -2,14 +2,23 @@
 
 #include "options.hpp"
 #include "color.hpp"
-#include <vector>
-#include <string>
+#include "output_sink.hpp"
+#include "line_layouts.hpp"
+#include "render_tables.hpp"
+#include "simd_kernels.hpp"
+#include <cstddef>
 #include <cstdint>
+#include <span>
+#include <string_view>
 
 namespace hexview {
 
 /**
  * @brief Handles formatting of hex dump output
+ *
+ * Lines are rendered straight into the output sink's buffer using lookup
+ * tables and the vectorized kernels selected for the running CPU, so
+ * producing a line performs no heap allocation.
  */
 class Formatter {
 public:
@@ -17,51 +26,227 @@ public:
      * @brief Construct a formatter
      * @param options Configuration options
      * @param color Color manager
+     * @param sink Destination for formatted lines
      */
-    Formatter(const Options& options, const Color& color);
+    Formatter(const Options& options, const Color& color, OutputSink& sink);
 
     /**
      * @brief Format a line of hex data
-     * @param bytes Bytes to format
+     * @param bytes Bytes to format (at most bytes_per_line)
+     * @param line_offset Offset of the first byte in the line
+     */
+    void format_line(std::span<const std::byte> bytes, std::uint64_t line_offset) const;
+
+    /**
+     * @brief Render a line of hex data into a caller-provided buffer
+     * @param bytes Bytes to format (at most bytes_per_line)
+     * @param line_offset Offset of the first byte in the line
+     * @param out Destination with room for at least max_line_size() characters
+     * @return Pointer one past the last character written (including the newline)
+     */
+    char* render_line(std::span<const std::byte> bytes, std::uint64_t line_offset, char* out) const;
+
+    /**
+     * @brief Render a line with some of its bytes highlighted
+     *
+     * Marked bytes (differences of a diff, pattern matches) get their own
+     * color; without color this is the same as render_line().
+     * @param bytes Bytes to format (at most bytes_per_line)
+     * @param marks One flag per byte, non-zero to highlight the byte
      * @param line_offset Offset of the first byte in the line
+     * @param out Destination with room for at least max_line_size() characters
+     * @return Pointer one past the last character written (including the newline)
+     */
+    char* render_marked_line(std::span<const std::byte> bytes, std::span<const std::uint8_t> marks,
+                             std::uint64_t line_offset, char* out) const;
+
+    /**
+     * @brief Render a marker that stands for a range of lines ("* LABEL BEGIN-END")
+     * @param label What the range is, at most MAX_MARKER_LABEL characters
+     * @param begin Offset of the first line of the range
+     * @param end Offset past the range
+     * @param out Destination with room for at least max_line_size() characters
+     * @return Pointer one past the last character written (including the newline)
+     */
+    char* render_marker(std::string_view label, std::uint64_t begin, std::uint64_t end, char* out) const;
+
+    /**
+     * @brief Longest label render_marker() accepts
+     */
+    static constexpr std::size_t MAX_MARKER_LABEL = 16;
+
+    /**
+     * @brief Render the marker that stands for lines skipped inside a file hole
+     * @param begin Offset of the first skipped line
+     * @param end Offset of the first line after the hole
+     * @param out Destination with room for at least max_line_size() characters
+     * @return Pointer one past the last character written (including the newline)
+     */
+    char* render_hole(std::uint64_t begin, std::uint64_t end, char* out) const;
+
+    /**
+     * @brief Render text found at an offset as one line ("OFFSET: text")
+     * @param offset Offset of the text's first byte
+     * @param text Printable characters
+     * @param out Destination with room for at least text_line_size(text.size()) characters
+     * @return Pointer one past the last character written (including the newline)
      */
-    void format_line(const std::vector<unsigned char>& bytes, std::uint64_t line_offset) const;
+    char* render_text_line(std::uint64_t offset, std::string_view text, char* out) const;
+
+    /**
+     * @brief Upper bound on the number of characters render_text_line() produces
+     */
+    std::size_t text_line_size(std::size_t text_size) const;
+
+    /**
+     * @brief Switch full lines to a compile-time specialized renderer
+     *
+     * Looks up the bytes-per-line/group preset (16/1, 16/2, 16/4, 32/4, 32/8)
+     * and column flags in a dispatch table. Colored output, escapes, bit and
+     * octal cells and other layouts keep using the generic renderer.
+     * @return true if a specialized renderer was selected
+     */
+    bool use_fixed_layout();
+
+    /**
+     * @brief Upper bound on the number of characters render_line() or render_hole() produces
+     */
+    std::size_t max_line_size() const { return max_line_size_; }
+
+    /**
+     * @brief Whether every full line's size depends only on its offset
+     *
+     * False when escapes or unequal color sequences make the size depend on
+     * the line's bytes.
+     */
+    bool fixed_line_size() const { return line_body_size_ != 0; }
+
+    /**
+     * @brief Exact number of characters render_line() produces for consecutive full lines
+     * @param first_offset Offset of the first line
+     * @param lines Number of lines, each bytes_per_line bytes after the previous one
+     * @return Total size in characters; only meaningful if fixed_line_size() is true
+     */
+    std::uint64_t full_lines_size(std::uint64_t first_offset, std::uint64_t lines) const;
 
 private:
     const Options& options_;
     const Color& color_;
+    OutputSink& sink_;
+    std::size_t group_;
+    const char* hex_pairs_;
+    const HexKernels& kernels_;
+    HexSpread spread_;
+    CellTable cells_;                   // hex, bits or octal digits of every byte value
+    std::size_t cell_width_;            // characters each byte takes in the hex column
+    std::size_t word_;                  // bytes shown as one hex word (1 => byte cells)
+    bool swap_words_;                   // little-endian words: digits run opposite to memory order
+    std::size_t value_width_;           // characters per value column cell, 0 => no value column
+    AsciiCellTable ascii_cells_;
+    std::string_view printable_color_;
+    std::string_view non_printable_color_;
+    std::string_view mark_color_;
+    std::string_view reset_color_;
+    std::size_t max_line_size_;
+    std::size_t line_body_size_;        // full line without the offset column, 0 if content dependent
+    char substitute_;
+
+    using FullLineRenderer = char* (Formatter::*)(const unsigned char*, std::uint64_t, char*) const;
+    FullLineRenderer full_line_ = nullptr;
 
     /**
-     * @brief Create hex column string
-     * @param bytes Bytes to format
-     * @return Formatted hex column
+     * @brief Render a full line with layout parameters fixed at compile time
+     * @tparam BPL Bytes per line
+     * @tparam GROUP Bytes per group
+     * @tparam COLUMNS Column layout
+     * @tparam OFFSET Whether the offset column is shown
+     * @tparam VECTOR Whether the hex column uses the vector spread kernel
+     * @param bytes Exactly BPL bytes
+     * @param line_offset Offset of the first byte in the line
+     * @param out Destination buffer
+     * @return Pointer one past the last character written (including the newline)
      */
-    std::string make_hex_column(const std::vector<unsigned char>& bytes) const;
+    template <std::size_t BPL, std::size_t GROUP, ColumnLayout COLUMNS, bool OFFSET, bool VECTOR>
+    char* render_fixed_line(const unsigned char* bytes, std::uint64_t line_offset, char* out) const;
 
     /**
-     * @brief Create ASCII column string
+     * @brief Render a line through the generic column renderers
      * @param bytes Bytes to format
-     * @return Formatted ASCII column
+     * @param count Number of bytes
+     * @param marks Highlight flag of each byte, or nullptr
+     * @param line_offset Offset of the first byte in the line
+     * @param out Destination buffer
+     * @return Pointer one past the last character written (including the newline)
+     */
+    char* render_generic_line(const unsigned char* bytes, std::size_t count, const std::uint8_t* marks,
+                              std::uint64_t line_offset, char* out) const;
+
+    /**
+     * @brief Color sequence of one byte cell
+     * @param i Index of the byte in the line
+     * @param printable classify_printable() mask of the 64-byte chunk holding byte i
+     * @param marks Highlight flag of each byte, or nullptr
+     */
+    std::string_view cell_color(std::size_t i, std::uint64_t printable, const std::uint8_t* marks) const;
+
+    /**
+     * @brief Render offset for the line
+     * @param line_offset Offset to render
+     * @param out Destination buffer
+     * @return Pointer one past the last character written
+     */
+    char* render_offset(std::uint64_t line_offset, char* out) const;
+
+    /**
+     * @brief Render the digits of an offset, without the ": " separator
+     * @param line_offset Offset to render
+     * @param out Destination buffer
+     * @return Pointer one past the last character written
+     */
+    char* render_offset_digits(std::uint64_t line_offset, char* out) const;
+
+    /**
+     * @brief Number of characters render_offset() produces
+     * @param line_offset Offset to render
+     * @return Offset column width including the ": " separator
+     */
+    std::size_t offset_size(std::uint64_t line_offset) const;
+
+    /**
+     * @brief Render hex (or bits/octal) column with coloring
+     * @param bytes Bytes to render
+     * @param count Number of bytes
+     * @param marks Highlight flag of each byte, or nullptr
+     * @param out Destination buffer
+     * @return Pointer one past the last character written
      */
-    std::string make_ascii_column(const std::vector<unsigned char>& bytes) const;
+    char* render_hex_column(const unsigned char* bytes, std::size_t count, const std::uint8_t* marks, char* out) const;
 
     /**
-     * @brief Print offset for the line
-     * @param line_offset Offset to print
+     * @brief Render the hex column as words, followed by the value column if enabled
+     * @param bytes Bytes to render
+     * @param count Number of bytes
+     * @param out Destination buffer
+     * @return Pointer one past the last character written
      */
-    void print_offset(std::uint64_t line_offset) const;
+    char* render_word_column(const unsigned char* bytes, std::size_t count, char* out) const;
 
     /**
-     * @brief Print hex column with coloring
-     * @param bytes Bytes to print
+     * @brief render_word_column() for a word size fixed at compile time
+     * @tparam WORD Bytes per word (2, 4 or 8)
      */
-    void print_hex_column_colored(const std::vector<unsigned char>& bytes) const;
+    template <std::size_t WORD>
+    char* render_words(const unsigned char* bytes, std::size_t count, char* out) const;
 
     /**
-     * @brief Print ASCII column with coloring
-     * @param bytes Bytes to print
+     * @brief Render ASCII column with coloring
+     * @param bytes Bytes to render
+     * @param count Number of bytes
+     * @param marks Highlight flag of each byte, or nullptr
+     * @param out Destination buffer
+     * @return Pointer one past the last character written
      */
-    void print_ascii_column_colored(const std::vector<unsigned char>& bytes) const;
+    char* render_ascii_column(const unsigned char* bytes, std::size_t count, const std::uint8_t* marks, char* out) const;
 };
 
-} // namespace hexview
\ No newline at end of file
+} // namespace hexview
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#  define HEXVIEW_HAVE_IO_URING 1
+#endif
+
+namespace hexview {
+
+/**
+ * @brief Minimal io_uring instance driven through the raw system calls
+ *
+ * Only what the block reader needs: queueing reads (optionally into
+ * registered buffers), submitting them and reaping completions. Ring
+ * indices shared with the kernel are accessed with acquire/release
+ * ordering as described in io_uring(7).
+ */
+class IoRing {
+public:
+    IoRing() = default;
+
+    /**
+     * @brief Unmap the rings and close the instance
+     */
+    ~IoRing();
+
+    IoRing(const IoRing&) = delete;
+    IoRing& operator=(const IoRing&) = delete;
+
+    /**
+     * @brief Create the ring
+     * @param entries Submission queue size
+     * @return false if io_uring is unavailable (old kernel, seccomp, non-Linux)
+     */
+    bool setup(unsigned entries);
+
+    /**
+     * @brief Register fixed buffers for read_fixed()
+     * @param base Start of the first buffer
+     * @param size Size of each buffer
+     * @param count Number of consecutive buffers
+     * @return false if registration failed (for example RLIMIT_MEMLOCK)
+     */
+    bool register_buffers(std::byte* base, std::size_t size, unsigned count);
+
+    /**
+     * @brief Whether register_buffers() succeeded
+     */
+    bool has_fixed_buffers() const { return fixed_buffers_; }
+
+    /**
+     * @brief Queue a read
+     * @param fd File to read
+     * @param data Destination (inside registered buffer buffer_index when fixed buffers are used)
+     * @param size Number of bytes to read
+     * @param offset File offset
+     * @param buffer_index Registered buffer holding data
+     * @param user_data Value returned with the completion
+     * @return false if the submission queue is full
+     */
+    bool queue_read(int fd, std::byte* data, std::size_t size, std::uint64_t offset,
+                    unsigned buffer_index, std::uint64_t user_data);
+
+    /**
+     * @brief Submit queued reads and optionally wait for completions
+     * @param wait_for Number of completions to wait for
+     * @return false on a system call error
+     */
+    bool submit(unsigned wait_for);
+
+    /**
+     * @brief Take one completion
+     * @param user_data Receives the value given to queue_read()
+     * @param result Receives the byte count or negative errno
+     * @return false if no completion is available
+     */
+    bool reap(std::uint64_t& user_data, std::int32_t& result);
+
+private:
+    int fd_ = -1;
+    void* sq_ring_ = nullptr;
+    std::size_t sq_ring_size_ = 0;
+    void* cq_ring_ = nullptr;
+    std::size_t cq_ring_size_ = 0;
+    void* sqes_ = nullptr;
+    std::size_t sqes_size_ = 0;
+
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    void* cqes_ = nullptr;
+
+    unsigned unsubmitted_ = 0;
+    bool fixed_buffers_ = false;
+};
+
+} // namespace hexview
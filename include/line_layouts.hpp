@@ -0,0 +1,77 @@
+#pragma once
+
+#include "options.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Compile-time line geometry for the specialized renderers
+namespace hexview {
+
+/**
+ * @brief Which columns a line shows and in which order
+ */
+enum class ColumnLayout {
+    HexAscii,
+    AsciiHex,
+    HexOnly,
+    AsciiOnly,
+};
+
+/**
+ * @brief Derive the column layout from the display options
+ * @param options Configuration options
+ * @return Column layout of every line
+ */
+inline ColumnLayout column_layout(const Options& options) {
+    if (options.hex_only) return ColumnLayout::HexOnly;
+    if (options.ascii_only) return ColumnLayout::AsciiOnly;
+    return options.swap_columns ? ColumnLayout::AsciiHex : ColumnLayout::HexAscii;
+}
+
+/**
+ * @brief Geometry of a full hex column for a fixed bytes-per-line and group size
+ *
+ * Every byte takes two hex digits followed by a one-space separator, widened
+ * to two spaces at the end of each group; the last byte has no separator.
+ */
+template <std::size_t BPL, std::size_t GROUP>
+struct LineLayout {
+    static_assert(BPL > 0 && GROUP > 0, "line layout needs at least one byte per line and group");
+
+    /**
+     * @brief Separator width after each byte (0 for the last byte)
+     */
+    static constexpr std::array<std::uint8_t, BPL> SEPARATORS = [] {
+        std::array<std::uint8_t, BPL> widths{};
+        for (std::size_t i = 0; i + 1 < BPL; ++i) {
+            widths[i] = ((i + 1) % GROUP == 0) ? 2 : 1;
+        }
+        return widths;
+    }();
+
+    /**
+     * @brief Column position of each byte's hex pair
+     */
+    static constexpr std::array<std::size_t, BPL> CELL_POSITIONS = [] {
+        std::array<std::size_t, BPL> positions{};
+        std::size_t pos = 0;
+        for (std::size_t i = 0; i < BPL; ++i) {
+            positions[i] = pos;
+            pos += 2 + std::size_t{SEPARATORS[i]};
+        }
+        return positions;
+    }();
+
+    /**
+     * @brief Width of the hex column in characters
+     */
+    static constexpr std::size_t HEX_WIDTH = CELL_POSITIONS[BPL - 1] + 2;
+
+    /**
+     * @brief Whether whole lines can go through the 16-byte spread kernels
+     */
+    static constexpr bool VECTOR_SPREAD = BPL % 16 == 0 && 16 % GROUP == 0;
+};
+
+} // namespace hexview
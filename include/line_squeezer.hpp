@@ -0,0 +1,97 @@
+#pragma once
+
+#include "formatter.hpp"
+#include "simd_kernels.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace hexview {
+
+/**
+ * @brief Collapses runs of identical full lines into a single "*" line
+ *
+ * The first line of a run is printed, the first repeat becomes "*" and
+ * further repeats are dropped. If the input ends inside a run, its last line
+ * is printed so the dump still shows where the data ends. Lines are
+ * compared with the vectorized mismatch kernel.
+ */
+class LineSqueezer {
+public:
+    /**
+     * @brief Construct a squeezer
+     * @param formatter Formatter used to render printed lines
+     * @param bytes_per_line Size of a full line
+     */
+    LineSqueezer(const Formatter& formatter, std::size_t bytes_per_line);
+
+    /**
+     * @brief Continue after lines that were handled elsewhere
+     *
+     * Used by chunked rendering: a chunk that does not start the dump is
+     * primed with the two lines in front of it so its first lines are
+     * classified exactly as in a sequential pass.
+     * @param before_previous Line two lines back (empty if none)
+     * @param previous Line right in front (empty if none)
+     */
+    void prime(std::span<const std::byte> before_previous, std::span<const std::byte> previous);
+
+    /**
+     * @brief Render a line unless it repeats the previous one
+     * @param line Line bytes (lines shorter than bytes_per_line are always printed)
+     * @param line_offset Offset of the first byte in the line
+     * @param out Destination with room for Formatter::max_line_size() characters
+     * @return Pointer one past the last character written
+     */
+    char* render(std::span<const std::byte> line, std::uint64_t line_offset, char* out);
+
+    /**
+     * @brief Render a run of identical full lines
+     *
+     * Gives the same output and state as rendering every line of the run,
+     * but only looks at its first and last line.
+     * @param line Bytes of each line of the run (bytes_per_line of them)
+     * @param begin Offset of the first line
+     * @param end Offset past the last line
+     * @param out Destination with room for 2 * Formatter::max_line_size() characters
+     * @return Pointer one past the last character written
+     */
+    char* render_run(std::span<const std::byte> line, std::uint64_t begin, std::uint64_t end, char* out);
+
+    /**
+     * @brief Replace lines inside a file hole with a single marker
+     *
+     * The marker counts as a printed zero line, so zero lines right after
+     * the hole become the usual "*" instead of vanishing behind it.
+     * @param begin Offset of the first skipped line
+     * @param end Offset of the first line after the hole
+     * @param out Destination with room for Formatter::max_line_size() characters
+     * @return Pointer one past the last character written
+     */
+    char* skip_hole(std::uint64_t begin, std::uint64_t end, char* out);
+
+    /**
+     * @brief Render the last dropped line when the input ends inside a run
+     * @param out Destination with room for Formatter::max_line_size() characters
+     * @return Pointer one past the last character written
+     */
+    char* finish(char* out);
+
+private:
+    const Formatter& formatter_;
+    const HexKernels& kernels_;
+    std::size_t bytes_per_line_;
+    std::vector<std::byte> previous_;       // last full line seen
+    bool have_previous_ = false;
+    bool previous_printed_ = false;         // previous line was printed rather than squeezed
+    bool held_ = false;                     // previous line was dropped
+    std::uint64_t held_offset_ = 0;
+
+    /**
+     * @brief Whether a full line equals the previous one
+     */
+    bool repeats(std::span<const std::byte> line) const;
+};
+
+} // namespace hexview
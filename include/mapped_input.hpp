@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace hexview {
+
+/**
+ * @brief Read-only memory mapping of a regular file or block device
+ *
+ * Small ranges are mapped in one piece. Ranges above LARGE_FILE_THRESHOLD
+ * are mapped in sliding windows aligned to the huge page size; above
+ * HUGE_FILE_THRESHOLD consumed windows are also dropped from the page cache
+ * so a single pass does not evict everything else.
+ */
+class MappedInput {
+public:
+    MappedInput() = default;
+
+    /**
+     * @brief Unmap the current window and close the file
+     */
+    ~MappedInput();
+
+    MappedInput(const MappedInput&) = delete;
+    MappedInput& operator=(const MappedInput&) = delete;
+
+    /**
+     * @brief Open a file for mapping
+     * @param path File to open
+     * @param start First byte that will be mapped
+     * @param length Number of bytes that will be mapped (0 = to the end)
+     * @return false if the file cannot be mapped and should be streamed instead
+     */
+    bool open(const std::string& path, std::uint64_t start, std::uint64_t length);
+
+    /**
+     * @brief Descriptor of the open file
+     */
+    int fd() const { return fd_; }
+
+    /**
+     * @brief First byte past the range given to open()
+     */
+    std::uint64_t end() const { return end_; }
+
+    /**
+     * @brief Map the window that starts at offset
+     * @param offset First byte wanted
+     * @param min_size Minimum number of bytes wanted (clamped to end())
+     * @return Bytes from offset to the end of the window, empty on failure
+     */
+    std::span<const std::byte> map_window(std::uint64_t offset, std::size_t min_size);
+
+private:
+    int fd_ = -1;
+    std::uint64_t end_ = 0;
+    std::uint64_t window_size_ = 0;
+    bool drop_cache_ = false;
+    bool huge_pages_ = false;
+    void* map_ = nullptr;
+    std::size_t map_size_ = 0;
+    std::uint64_t map_offset_ = 0;
+
+    /**
+     * @brief Unmap the current window
+     */
+    void unmap();
+};
+
+} // namespace hexview
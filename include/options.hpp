@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -10,11 +11,16 @@ namespace hexview {
  */
 struct Options {
     enum class OffsetFormat { Hex, Dec };
+    enum class Style { Dump, Plain, Include };
+    enum class Encoding { Hex, Bits, Octal };
+    enum class Endian { Little, Big };
+    enum class WordValues { None, Dec, Float };
+    enum class Checksum { None, Crc32c, Xxh64 };
 
     std::string filename = "";                       // "-" => stdin
     std::uint64_t start = 0;                        // start offset in bytes
     std::uint64_t length = 0;                       // 0 => no limit
-    std::size_t bytes_per_line = 16;                // how many bytes per line
+    std::size_t bytes_per_line = 0;                 // how many bytes per line (0 => default for the style)
     std::size_t group = 1;                          // grouping of bytes for spacing
     std::size_t offset_width = 8;                   // width in hex digits for offset when hex shown
     bool uppercase = false;                         // uppercase hex digits
@@ -27,7 +33,37 @@ struct Options {
     bool swap_columns = false;                      // ASCII left, hex right
     bool hide_offset = false;                       // do not print offset column
     bool show_escapes = false;                      // show escapes for control chars and \xHH for others
+    bool squeeze = true;                            // replace runs of identical lines with "*"
+    bool vmsplice = false;                          // gift output pages to a stdout pipe with vmsplice(2)
+    std::string output = "";                        // write the dump to this file instead of stdout
+    bool pipeline = false;                          // overlap reading, formatting and writing on three threads
+    std::size_t queue_depth = 0;                    // reads kept in flight for files (0 => memory map instead)
+    std::size_t threads = 1;                        // render threads for seekable inputs (0 => one per CPU)
+    bool reverse = false;                           // turn a dump (or plain hex) back into binary
+    bool diff = false;                              // show the lines where filename and diff_filename differ
+    std::string diff_filename = "";                 // second input of --diff
+    bool side_by_side = false;                      // --diff lines side by side instead of interleaved
+    std::string find = "";                          // dump only the lines holding this pattern
+    bool find_text = false;                         // the pattern is text (--find-text), not hex (--find)
+    std::size_t context = 0;                        // lines shown before and after each match
+    std::string signatures = "";                    // list every occurrence of the named patterns in this file
+    std::size_t strings = 0;                        // list printable runs of at least this many characters (0 => off)
+    bool utf16 = false;                             // --strings also lists UTF-16LE strings
+    std::size_t entropy = 0;                        // summarize the entropy of blocks of this many bytes (0 => off)
+    Checksum checksum = Checksum::None;             // list a checksum of every checksum_block bytes
+    std::size_t checksum_block = 0;                 // bytes per checksummed block (0 => default)
+    bool annotate = false;                          // dump, with each checksum after the line that ends its block
+    bool index = false;                             // load or build the block index of the input file
+    std::string index_file = "";                    // sidecar holding the index ("" => the file name plus ".hvidx")
+    bool summary = false;                           // list runs of similar blocks from the index
+    bool next_data = false;                         // move the start offset past blocks of one repeated byte
+    bool interactive = false;                       // browse the input in a full-screen pager
     OffsetFormat offset_format = OffsetFormat::Hex;
+    Style style = Style::Dump;                      // offset/hex/ASCII lines, plain hex (-p) or a C array (-i)
+    Encoding encoding = Encoding::Hex;              // digits of each byte cell: hex, binary (-b) or octal
+    std::size_t word = 1;                           // bytes shown as one hex word (1, 2, 4 or 8)
+    Endian endian = Endian::Little;                 // byte order of the words
+    WordValues word_values = WordValues::None;      // extra column with each word as unsigned decimal or float
 
     /**
      * @brief Validate options for conflicts and set defaults
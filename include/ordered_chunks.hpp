@@ -0,0 +1,117 @@
+#pragma once
+
+#include "config.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace hexview {
+
+/**
+ * @brief Reorder buffer for chunks processed on a thread pool
+ *
+ * The calling thread fills a free slot with the next chunk, a worker
+ * processes it and the processed slots come back to the calling thread
+ * strictly in the order they were filled. At most
+ * threads * REORDER_SLOTS_PER_THREAD chunks are in flight, which caps
+ * memory no matter how large the input is; slots are reused, so their
+ * buffers are allocated once.
+ * @tparam Slot Per-chunk state (offsets, buffers, errno of a failed read)
+ */
+template <class Slot>
+class OrderedChunks {
+public:
+    /**
+     * @brief Allocate the slots and start the workers
+     * @param threads Number of workers (at least one is started)
+     */
+    explicit OrderedChunks(std::size_t threads)
+        : slots_(std::max<std::size_t>(1, threads) * REORDER_SLOTS_PER_THREAD),
+          ready_(slots_.size(), 0),
+          pool_(threads) {}
+
+    OrderedChunks(const OrderedChunks&) = delete;
+    OrderedChunks& operator=(const OrderedChunks&) = delete;
+
+    /**
+     * @brief The slots, e.g. to size their buffers before run()
+     */
+    std::vector<Slot>& slots() { return slots_; }
+
+    /**
+     * @brief Process chunks until the input ends or emit stops
+     *
+     * Processed slots are emitted as soon as they are ready while free
+     * slots remain, so a fill that reads a stream keeps the workers busy.
+     * Returns only after every submitted chunk has been processed.
+     * @param fill Called on this thread with a free slot; returns false when no chunk is left
+     * @param work Called on a worker thread with a filled slot
+     * @param emit Called on this thread with each processed slot in order; returns false to stop
+     */
+    template <class Fill, class Work, class Emit>
+    void run(Fill&& fill, Work&& work, Emit&& emit) {
+        const std::size_t count = slots_.size();
+        std::uint64_t submitted = 0;
+        std::uint64_t emitted = 0;
+        bool more = true;
+
+        for (;;) {
+            if (more && submitted - emitted < count) {
+                const std::size_t index = submitted % count;
+                if (!fill(slots_[index])) {
+                    more = false;
+                    continue;
+                }
+                ++submitted;
+                ready_[index] = 0;
+                pool_.submit([this, index, &work] {
+                    work(slots_[index]);
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        ready_[index] = 1;
+                    }
+                    ready_cv_.notify_all();
+                });
+
+                // Emit what is already processed, but keep filling while slots are free
+                bool stop = false;
+                while (!stop && emitted < submitted && is_ready(emitted % count)) {
+                    stop = !emit(slots_[emitted++ % count]);
+                }
+                if (stop) break;
+                continue;
+            }
+            if (emitted == submitted) break;
+
+            wait(emitted % count);
+            if (!emit(slots_[emitted++ % count])) break;
+        }
+
+        // Queued tasks refer to work and the slots
+        for (; emitted < submitted; ++emitted) wait(emitted % count);
+    }
+
+private:
+    std::vector<Slot> slots_;
+    std::vector<char> ready_;               // per slot, guarded by mutex_
+    std::mutex mutex_;
+    std::condition_variable ready_cv_;
+    // Declared last so queued tasks finish before the slots go away
+    ThreadPool pool_;
+
+    bool is_ready(std::size_t index) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return ready_[index] != 0;
+    }
+
+    void wait(std::size_t index) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_cv_.wait(lock, [this, index] { return ready_[index] != 0; });
+    }
+};
+
+} // namespace hexview
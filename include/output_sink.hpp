@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace hexview {
+
+/**
+ * @brief Block-buffered writer on a raw file descriptor
+ *
+ * Rendered output is collected in a buffer sized for the destination (pipe
+ * capacity for pipes, a multiple of st_blksize otherwise) and flushed with
+ * write(2)/writev(2). When the destination is a pipe the buffer pages can
+ * optionally be gifted to the kernel with vmsplice(2) instead of copied.
+ */
+class OutputSink {
+public:
+    /**
+     * @brief Construct a sink for a file descriptor
+     * @param fd Destination file descriptor (not closed by the sink)
+     * @param use_vmsplice Try to gift pages with vmsplice when fd is a pipe
+     */
+    explicit OutputSink(int fd, bool use_vmsplice = false);
+
+    /**
+     * @brief Flush pending output and release the buffer
+     */
+    ~OutputSink();
+
+    OutputSink(const OutputSink&) = delete;
+    OutputSink& operator=(const OutputSink&) = delete;
+
+    /**
+     * @brief Get a write pointer with room for at least size characters
+     * @param size Number of characters the caller may write
+     * @return Pointer into the buffer, to be passed back through commit()
+     */
+    char* reserve(std::size_t size);
+
+    /**
+     * @brief Mark characters written after reserve() as pending output
+     * @param end Pointer one past the last character written
+     */
+    void commit(char* end) { used_ = static_cast<std::size_t>(end - buffer_); }
+
+    /**
+     * @brief Append data, writing large blocks without copying them
+     * @param data Characters to append
+     */
+    void write(std::string_view data);
+
+    /**
+     * @brief Write all pending output to the file descriptor
+     * @return true if every write so far has succeeded
+     */
+    bool flush();
+
+    /**
+     * @brief Buffer size chosen for the destination
+     */
+    std::size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief Whether all writes so far have succeeded
+     */
+    bool good() const { return !failed_; }
+
+private:
+    int fd_;
+    std::size_t capacity_ = 0;
+    std::size_t used_ = 0;
+    char* buffer_ = nullptr;
+    bool vmsplice_ = false;
+    bool mapped_ = false;
+    bool failed_ = false;
+
+    /**
+     * @brief Allocate a buffer of capacity_ bytes (page aligned for vmsplice)
+     */
+    void allocate_buffer();
+
+    /**
+     * @brief Release the current buffer
+     */
+    void release_buffer();
+
+    /**
+     * @brief Write two pieces of data with as few system calls as possible
+     * @param first First piece (usually the pending buffer)
+     * @param second Second piece (may be empty)
+     */
+    void write_fully(std::string_view first, std::string_view second = {});
+
+    /**
+     * @brief Gift the pending buffer pages to a pipe
+     * @return Number of bytes transferred before vmsplice stopped or failed
+     */
+    std::size_t splice_buffer();
+};
+
+} // namespace hexview
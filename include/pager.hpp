@@ -0,0 +1,160 @@
+#pragma once
+
+#include "options.hpp"
+#include "formatter.hpp"
+#include "finder.hpp"
+#include "simd_kernels.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hexview {
+
+/**
+ * @brief Full-screen pager over a seekable input (--interactive)
+ *
+ * Only the lines on the screen are read (with pread()) and rendered with
+ * the Formatter, so drawing a screen costs the same at any offset of any
+ * file. Rendered screens are kept in a small LRU cache, and after every
+ * draw a worker thread renders the screens above and below into it, so
+ * paging is a cache hit. The terminal is driven with termios and ANSI
+ * escape sequences only; keys: arrows/j/k lines, PgUp/PgDn/b/space screens,
+ * Home/End, g offset or percentage, / hex and s text search, n next match,
+ * q quit.
+ */
+class Pager {
+public:
+    /**
+     * @brief Construct a pager
+     * @param options Configuration options (filename, start, length; find gives a first pattern)
+     * @param formatter Formatter used to render the lines
+     * @throws std::invalid_argument if the --find pattern is malformed
+     */
+    Pager(const Options& options, const Formatter& formatter);
+
+    /**
+     * @brief Show the input until the user quits
+     * @return 0 for success, error code otherwise
+     */
+    int run();
+
+private:
+    /**
+     * @brief What a rendered screen depends on besides its first line
+     */
+    struct Layout {
+        std::size_t rows = 0;               // dump lines per screen
+        std::uint64_t generation = 0;       // changes with the terminal size and the highlighted match
+        std::uint64_t match_begin = 0;      // highlighted bytes (empty when there is no match)
+        std::uint64_t match_end = 0;
+    };
+
+    /**
+     * @brief A rendered screen in the cache
+     */
+    struct Page {
+        std::uint64_t top = 0;              // offset of the first line
+        std::uint64_t generation = 0;       // Layout::generation it was rendered for
+        std::uint64_t last_use = 0;         // LRU stamp
+        std::string text;                   // lines ready for the terminal
+        int error = 0;                      // errno of a failed read (such pages are not cached)
+        std::uint64_t error_offset = 0;     // where the failed read stopped
+    };
+
+    const Options& options_;
+    const Formatter& formatter_;
+    const HexKernels& kernels_;
+    int fd_ = -1;
+    std::uint64_t end_ = 0;                 // first byte past the viewed range
+    std::size_t columns_ = 80;
+    Layout layout_;
+    std::uint64_t top_ = 0;                 // offset of the first line on the screen
+    std::string message_;                   // shown in the status line until the next key
+
+    SearchPattern pattern_;                 // empty until a pattern is given
+    std::size_t first_ = 0;                 // first and last pattern bytes without wildcards
+    std::size_t last_ = 0;
+
+    std::mutex cache_mutex_;                // guards cache_ and use_clock_ (shared with the prefetcher)
+    std::vector<Page> cache_;
+    std::uint64_t use_clock_ = 0;
+    std::atomic<std::uint64_t> prefetch_round_{0}; // bumped per drawn screen; older prefetches are skipped
+
+    /**
+     * @brief Bytes shown on one screen
+     */
+    std::uint64_t page_bytes() const { return static_cast<std::uint64_t>(layout_.rows) * options_.bytes_per_line; }
+
+    /**
+     * @brief Offset of the line that holds an offset, clamped to the viewed range
+     */
+    std::uint64_t line_of(std::uint64_t offset) const;
+
+    /**
+     * @brief Offset of the first line of the last screen
+     */
+    std::uint64_t last_top() const;
+
+    /**
+     * @brief Read and render the screen that starts at top (safe on any thread)
+     *
+     * Lines past a failed read are shown like lines past the end; the
+     * page's error tells them apart.
+     */
+    Page render_page(std::uint64_t top, const Layout& layout) const;
+
+    /**
+     * @brief Get a screen from the cache, rendering and caching it on a miss
+     */
+    Page fetch_page(std::uint64_t top);
+
+    /**
+     * @brief Render a screen into the cache unless it is there (runs on the prefetch worker)
+     * @param round Value of prefetch_round_ when it was queued; the user has moved on when they differ
+     */
+    void prefetch_page(std::uint64_t top, Layout layout, std::uint64_t round);
+
+    /**
+     * @brief Add a screen to the cache, evicting the least recently used one
+     */
+    void store_page(Page page);
+
+    /**
+     * @brief Query the terminal size and start a new layout generation
+     */
+    void update_size();
+
+    /**
+     * @brief Draw the screen at top_ and the status line
+     */
+    void draw();
+
+    /**
+     * @brief Read a line of input in the status line
+     * @param label Text in front of the input
+     * @param line Receives the input
+     * @return false if the user cancelled with Esc
+     */
+    bool prompt(const std::string& label, std::string& line);
+
+    /**
+     * @brief Use a new search pattern (with the filter anchors of --find)
+     * @throws std::invalid_argument if the pattern is malformed or has no fixed byte
+     */
+    void set_pattern(SearchPattern pattern);
+
+    /**
+     * @brief Find the next match after the highlighted one (or from the screen top) and show it
+     */
+    void search_next();
+
+    /**
+     * @brief Move to an offset or percentage typed by the user
+     */
+    void go_to(const std::string& where);
+};
+
+} // namespace hexview
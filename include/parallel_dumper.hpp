@@ -0,0 +1,97 @@
+#pragma once
+
+#include "options.hpp"
+#include "formatter.hpp"
+#include "output_sink.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hexview {
+
+/**
+ * @brief Multi-threaded dump of a seekable input
+ *
+ * The range is split into line-aligned chunks that workers of a ThreadPool
+ * read with pread() and render with Formatter::render_line(). Rendered
+ * chunks are written strictly in offset order; at most
+ * threads * REORDER_SLOTS_PER_THREAD chunks are in flight, which caps memory
+ * no matter how large the input is. When squeezing, lines inside holes of
+ * a sparse file are not read but become a single marker. When the output
+ * is a regular file and line sizes are known in advance, chunks are
+ * written at their final positions instead.
+ */
+class ParallelDumper {
+public:
+    /**
+     * @brief Construct a parallel dumper
+     * @param options Configuration options (threads gives the worker count)
+     * @param formatter Formatter used to render lines; only const members are called
+     * @param sink Destination of the rendered chunks
+     */
+    ParallelDumper(const Options& options, const Formatter& formatter, OutputSink& sink);
+
+    /**
+     * @brief Close the input file
+     */
+    ~ParallelDumper();
+
+    ParallelDumper(const ParallelDumper&) = delete;
+    ParallelDumper& operator=(const ParallelDumper&) = delete;
+
+    /**
+     * @brief Open a file for positional reads
+     * @param path File to open
+     * @return false if the file is not seekable and should be streamed instead
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Render the requested range and write it to the sink
+     * @return 0 for success, error code otherwise
+     */
+    int run();
+
+    /**
+     * @brief Render the requested range straight into a regular file
+     *
+     * Needs Formatter::fixed_line_size(): every chunk's position in the
+     * output is computed up front, the file is sized with ftruncate() and
+     * workers pwrite() their chunks in any order, so no reorder buffer is
+     * involved.
+     * @param out_fd Regular file opened for writing; nothing may have been written yet
+     * @return 0 for success, error code otherwise
+     */
+    int run_positional(int out_fd);
+
+private:
+    /**
+     * @brief One entry of the reorder buffer
+     */
+    struct ChunkSlot {
+        std::uint64_t offset = 0;           // first byte of the chunk
+        std::uint64_t end = 0;              // first byte past the chunk
+        std::size_t length = 0;             // bytes requested, then bytes read
+        std::vector<std::byte> input;       // bytes read with pread()
+        std::vector<char> output;           // rendered lines
+        std::size_t output_size = 0;        // characters used in output
+        int error = 0;                      // errno of a failed read
+        bool hole = false;                  // lines inside a file hole, rendered as a marker
+        bool after_hole = false;            // starts right after a hole marker
+    };
+
+    const Options& options_;
+    const Formatter& formatter_;
+    OutputSink& sink_;
+    int fd_ = -1;
+    std::uint64_t end_ = 0;
+
+    /**
+     * @brief Read and render one chunk (runs on a worker thread)
+     * @param slot Chunk to fill; offset and length are set by the caller
+     */
+    void render_chunk(ChunkSlot& slot) const;
+};
+
+} // namespace hexview
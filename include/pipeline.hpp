@@ -0,0 +1,104 @@
+#pragma once
+
+#include "options.hpp"
+#include "config.hpp"
+#include "formatter.hpp"
+#include "line_squeezer.hpp"
+#include "output_sink.hpp"
+#include "spsc_ring.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace hexview {
+
+/**
+ * @brief Three-stage reader/formatter/writer dump of any input
+ *
+ * A reader thread fills input blocks, the calling thread renders them and
+ * a writer thread hands the rendered blocks to the sink. Stages exchange
+ * buffer indices through single-producer/single-consumer rings; the
+ * buffers themselves are allocated once and recycled, so the steady state
+ * performs no allocation. Works on pipes and other non-seekable inputs;
+ * holes of sparse files are squeezed without being read.
+ */
+class Pipeline {
+public:
+    /**
+     * @brief Construct a pipeline and allocate its buffer pool
+     * @param options Configuration options
+     * @param formatter Formatter used to render lines
+     * @param sink Destination of the rendered blocks (used only by the writer thread)
+     */
+    Pipeline(const Options& options, const Formatter& formatter, OutputSink& sink);
+
+    /**
+     * @brief Dump an input from its current position
+     *
+     * options.start bytes are skipped first and at most options.length
+     * bytes are dumped after that.
+     * @param fd Input file descriptor
+     * @return 0 for success, error code otherwise
+     */
+    int run(int fd);
+
+private:
+    /**
+     * @brief Message passed between the stages
+     */
+    struct Block {
+        std::uint32_t index = 0;    // buffer in the input or output pool
+        std::int32_t error = 0;     // errno of a failed read (end marker only)
+        std::size_t size = 0;       // bytes or characters used in the buffer
+        std::uint64_t hole_end = 0; // hole of a sparse file up to here, carries no buffer
+        bool last = false;          // end of stream marker, carries no buffer
+    };
+
+    using Queue = SpscRing<Block, PIPELINE_BUFFERS>;
+
+    const Options& options_;
+    const Formatter& formatter_;
+    OutputSink& sink_;
+    std::size_t block_size_;
+    std::size_t output_size_;
+    std::vector<std::byte> inputs_;
+    std::vector<char> outputs_;
+    std::vector<std::byte> pending_;        // partial line carried into the next block
+    LineSqueezer squeezer_;
+
+    Queue free_inputs_;                     // formatter -> reader
+    Queue filled_;                          // reader -> formatter
+    Queue free_outputs_;                    // writer -> formatter
+    Queue rendered_;                        // formatter -> writer
+    std::atomic<bool> write_failed_{false};
+
+    /**
+     * @brief Reader stage: skip to the start offset, then fill input blocks
+     * @param fd Input file descriptor
+     */
+    void read_stage(int fd);
+
+    /**
+     * @brief Writer stage: pass rendered blocks to the sink
+     */
+    void write_stage();
+
+    /**
+     * @brief Render one line, squeezing repeats unless -v was given
+     */
+    char* render_line(std::span<const std::byte> line, std::uint64_t offset, char* out);
+
+    /**
+     * @brief Render the lines of one input block, stitching lines split across blocks
+     * @param data Input block
+     * @param offset Offset of the first pending byte, or of data when nothing is pending
+     * @param pending Bytes of a partial line carried over from earlier blocks
+     * @param out Destination buffer
+     * @return Pointer one past the last character written
+     */
+    char* render_block(std::span<const std::byte> data, std::uint64_t offset, std::size_t& pending, char* out);
+};
+
+} // namespace hexview
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "options.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Lookup tables used by the line renderer to avoid per-byte formatting work
+namespace hexview {
+
+/**
+ * @brief 256 two-character hex pairs laid out back to back ("000102...ff")
+ */
+using HexPairTable = std::array<char, 512>;
+
+/**
+ * @brief 256 C literals ("0x00, ", "0X00, " in uppercase) padded to 8 characters so each is one 64-bit store
+ */
+using CByteTable = std::array<char, 256 * 8>;
+
+/**
+ * @brief 256 byte cells of the active encoding (hex, bits or octal) padded to 8 characters so each is one 64-bit store
+ */
+using CellTable = std::array<char, 256 * 8>;
+
+/**
+ * @brief Pre-rendered representation of one byte in the ASCII column
+ */
+struct AsciiCell {
+    char text[4];          // up to 4 characters ("\xHH" is the longest form)
+    std::uint8_t size;     // number of valid characters in text
+};
+
+using AsciiCellTable = std::array<AsciiCell, 256>;
+
+constexpr HexPairTable make_hex_pair_table(bool uppercase) {
+    const char* digits = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    HexPairTable table{};
+    for (std::size_t b = 0; b < 256; ++b) {
+        table[2 * b] = digits[b >> 4];
+        table[2 * b + 1] = digits[b & 0x0F];
+    }
+    return table;
+}
+
+inline constexpr HexPairTable HEX_PAIRS_LOWER = make_hex_pair_table(false);
+inline constexpr HexPairTable HEX_PAIRS_UPPER = make_hex_pair_table(true);
+
+/**
+ * @brief Get the hex pair table for the requested letter case
+ * @param uppercase Whether to use uppercase letters
+ * @return Pointer to 512 characters, the pair for byte b starts at 2 * b
+ */
+constexpr const char* hex_pairs(bool uppercase) {
+    return uppercase ? HEX_PAIRS_UPPER.data() : HEX_PAIRS_LOWER.data();
+}
+
+constexpr CByteTable make_c_byte_table(bool uppercase) {
+    const char* pairs = hex_pairs(uppercase);
+    CByteTable table{};
+    for (std::size_t b = 0; b < 256; ++b) {
+        char* entry = &table[8 * b];
+        entry[0] = '0';
+        entry[1] = uppercase ? 'X' : 'x';  // xxd -i -u spells the prefix 0X
+        entry[2] = pairs[2 * b];
+        entry[3] = pairs[2 * b + 1];
+        entry[4] = ',';
+        entry[5] = ' ';
+        entry[6] = ' ';
+        entry[7] = ' ';
+    }
+    return table;
+}
+
+inline constexpr CByteTable C_BYTES_LOWER = make_c_byte_table(false);
+inline constexpr CByteTable C_BYTES_UPPER = make_c_byte_table(true);
+
+/**
+ * @brief Width of one byte cell in characters
+ * @param encoding Digits used for each byte
+ * @return 2 for hex, 8 for bits, 3 for octal
+ */
+constexpr std::size_t cell_width(Options::Encoding encoding) {
+    switch (encoding) {
+    case Options::Encoding::Bits: return 8;
+    case Options::Encoding::Octal: return 3;
+    default: return 2;
+    }
+}
+
+/**
+ * @brief Build the cell of every byte value for an encoding
+ *
+ * Characters past cell_width(encoding) are spaces; renderers store all 8
+ * and advance by the cell width.
+ */
+constexpr CellTable make_cell_table(Options::Encoding encoding, bool uppercase) {
+    const char* pairs = hex_pairs(uppercase);
+    CellTable table{};
+    for (std::size_t b = 0; b < 256; ++b) {
+        char* cell = &table[8 * b];
+        for (std::size_t i = 0; i < 8; ++i) cell[i] = ' ';
+        if (encoding == Options::Encoding::Bits) {
+            for (std::size_t i = 0; i < 8; ++i) cell[i] = ((b >> (7 - i)) & 1) ? '1' : '0';
+        } else if (encoding == Options::Encoding::Octal) {
+            cell[0] = static_cast<char>('0' + (b >> 6));
+            cell[1] = static_cast<char>('0' + ((b >> 3) & 7));
+            cell[2] = static_cast<char>('0' + (b & 7));
+        } else {
+            cell[0] = pairs[2 * b];
+            cell[1] = pairs[2 * b + 1];
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief Build the ASCII column representation for every byte value
+ *
+ * Mirrors escape_byte(): printable bytes map to themselves, others map to
+ * "\n", "\r", "\t" or "\xHH" when escapes are shown, otherwise to '.' or '?'.
+ */
+constexpr AsciiCellTable make_ascii_cell_table(bool show_escapes, bool ascii_dot_if_not) {
+    AsciiCellTable table{};
+    for (std::size_t b = 0; b < 256; ++b) {
+        AsciiCell& cell = table[b];
+        const char ch = static_cast<char>(b);
+        if (b >= 32 && b <= 126) {
+            cell.text[0] = ch;
+            cell.size = 1;
+        } else if (!show_escapes) {
+            cell.text[0] = ascii_dot_if_not ? '.' : '?';
+            cell.size = 1;
+        } else if (b == '\n' || b == '\r' || b == '\t') {
+            cell.text[0] = '\\';
+            cell.text[1] = b == '\n' ? 'n' : (b == '\r' ? 'r' : 't');
+            cell.size = 2;
+        } else {
+            cell.text[0] = '\\';
+            cell.text[1] = 'x';
+            cell.text[2] = HEX_PAIRS_LOWER[2 * b];
+            cell.text[3] = HEX_PAIRS_LOWER[2 * b + 1];
+            cell.size = 4;
+        }
+    }
+    return table;
+}
+
+} // namespace hexview
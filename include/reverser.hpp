@@ -0,0 +1,115 @@
+#pragma once
+
+#include "options.hpp"
+#include "simd_kernels.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace hexview {
+
+/**
+ * @brief Turns a hexview dump, or a plain hex stream, back into binary
+ *
+ * Dump lines are parsed with the layout options the dump was made with
+ * (bytes per line, grouping, column order, offset format). The hex cells
+ * of a line are gathered and decoded with the vectorized decode kernel.
+ * "*" lines are expanded by repeating the previous line up to the next
+ * offset, and lines that do not start with an offset are read as plain
+ * hex. When the output is a regular file, bytes are written with pwrite()
+ * at their offsets, so offset gaps, hole markers and squeezed zero lines
+ * leave holes and the result is sparse.
+ */
+class HexReverser {
+public:
+    /**
+     * @brief Construct a reverser
+     * @param options Layout options of the dump being reversed
+     * @param out_fd Destination of the binary output
+     */
+    HexReverser(const Options& options, int out_fd);
+
+    /**
+     * @brief Read a dump to its end and write the bytes it describes
+     * @param in_fd Input file descriptor
+     * @return 0 for success, error code otherwise
+     */
+    int run(int in_fd);
+
+private:
+    const Options& options_;
+    const HexKernels& kernels_;
+    int out_fd_;
+    bool positional_ = false;               // output is a regular file written with pwrite()
+    std::uint64_t base_ = 0;                // output position of offset 0 (positional only)
+
+    std::vector<std::size_t> cells_;        // position of every cell in the hex column
+    std::size_t hex_column_ = 0;            // characters in front of the hex column, after the offset
+    std::vector<char> gathered_;            // hex digits of one line without separators
+    std::vector<unsigned char> plain_;      // bytes of a plain hex line decoded in one call
+
+    std::vector<unsigned char> line_;       // bytes of the last dump line
+    std::size_t line_size_ = 0;
+    bool line_zero_ = false;                // last dump line is all zero bytes
+    bool repeat_ = false;                   // "*" seen: the last line repeats up to the next offset
+    bool repeat_warned_ = false;
+    std::uint64_t position_ = 0;            // offset of the next byte
+    int nibble_ = -1;                       // high nibble of a plain hex pair split across lines
+
+    std::vector<unsigned char> pending_;    // decoded bytes not written yet
+    std::uint64_t pending_offset_ = 0;      // offset of pending_[0]
+    std::uint64_t end_ = 0;                 // first offset past everything written
+    int write_error_ = 0;
+
+    /**
+     * @brief Handle one line of input (without its newline)
+     * @return false if the line is malformed
+     */
+    bool parse_line(std::string_view line);
+
+    /**
+     * @brief Parse an offset column value
+     * @param text Digits in the dump's offset format
+     * @param value Receives the offset
+     * @return false if text is not a complete number
+     */
+    bool parse_offset(std::string_view text, std::uint64_t& value) const;
+
+    /**
+     * @brief Decode the hex column of a dump line
+     * @param text Line without its offset column
+     * @param offset Offset of the line's first byte
+     * @return false if a cell is not a hex pair
+     */
+    bool parse_columns(std::string_view text, std::uint64_t offset);
+
+    /**
+     * @brief Decode plain hex digits, ignoring whitespace
+     * @return false on a character that is neither
+     */
+    bool parse_plain(std::string_view text);
+
+    /**
+     * @brief Repeat the last dump line up to an offset ("*" lines)
+     * @param until Offset of the next dump line
+     */
+    void expand_repeats(std::uint64_t until);
+
+    /**
+     * @brief Queue bytes for writing at an offset
+     */
+    void emit(std::uint64_t offset, const unsigned char* data, std::size_t size);
+
+    /**
+     * @brief Write the queued bytes
+     */
+    void flush();
+
+    /**
+     * @brief Write bytes at an offset (positional) or at the current stream position
+     */
+    void write_at(std::uint64_t offset, const unsigned char* data, std::size_t size);
+};
+
+} // namespace hexview
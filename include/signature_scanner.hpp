@@ -0,0 +1,172 @@
+#pragma once
+
+#include "options.hpp"
+#include "formatter.hpp"
+#include "output_sink.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace hexview {
+
+/**
+ * @brief Named byte patterns compiled into an Aho-Corasick automaton
+ *
+ * Bytes that occur in no pattern share one input class and every other
+ * byte gets a class of its own, so a state's row of transitions has one
+ * entry per class instead of 256. The rows are stored back to back in one
+ * flat table; failure links are folded into it, so scanning costs one
+ * table load per input byte. A transition holds the target's row offset,
+ * with MATCH_BIT set when the target completes at least one signature.
+ */
+class SignatureSet {
+public:
+    /**
+     * @brief One occurrence of a signature
+     */
+    struct Hit {
+        std::uint64_t offset;               // first byte of the occurrence
+        std::uint32_t signature;            // index of the signature
+    };
+
+    /**
+     * @brief Load and compile a signatures file
+     *
+     * Each line holds a name and a pattern: hex bytes ("7f 45 4c 46") or
+     * quoted text ("\"PK\\x03\\x04\""). Blank lines and lines starting
+     * with '#' are ignored.
+     * @param path Signatures file
+     * @throws std::invalid_argument if the file cannot be read or a line is malformed
+     */
+    explicit SignatureSet(const std::string& path);
+
+    /**
+     * @brief Find the signatures in a block of input
+     * @param data Bytes to scan; the automaton starts from its root at data[0]
+     * @param offset Offset of data[0]
+     * @param limit Only occurrences starting before data[limit] are reported
+     * @param hits Receives the occurrences, ordered by offset, then signature
+     */
+    void scan(std::span<const std::byte> data, std::uint64_t offset, std::size_t limit, std::vector<Hit>& hits) const;
+
+    const std::string& name(std::uint32_t signature) const { return names_[signature]; }
+    std::size_t length(std::uint32_t signature) const { return lengths_[signature]; }
+    std::size_t longest() const { return longest_; }
+    std::size_t longest_name() const { return longest_name_; }
+
+private:
+    static constexpr std::uint32_t MATCH_BIT = 0x80000000u;
+
+    std::vector<std::string> names_;
+    std::vector<std::size_t> lengths_;
+    std::size_t longest_ = 0;
+    std::size_t longest_name_ = 0;
+    std::array<std::uint32_t, 256> classes_{};  // input class of every byte value
+    std::size_t stride_ = 0;                    // number of classes (entries per state row)
+    std::vector<std::uint32_t> table_;          // transitions, one row per state
+    std::vector<std::uint32_t> output_begin_;   // per state: first entry in outputs_ (one extra at the end)
+    std::vector<std::uint32_t> outputs_;        // signatures completed by each state
+
+    /**
+     * @brief Build the automaton from the patterns
+     */
+    void compile(const std::vector<std::vector<unsigned char>>& patterns);
+};
+
+/**
+ * @brief Lists every occurrence of a set of signatures (--signatures)
+ *
+ * Each hit is one line: the signature name followed by a line rendered by
+ * the Formatter from the hit's offset, so it shows the offset and a short
+ * hex and ASCII preview with the signature bytes highlighted. Seekable
+ * inputs are split into chunks scanned on a thread pool; each chunk is
+ * read with enough overlap to finish the occurrences that start in it and
+ * their previews, and the results are written in offset order. Other
+ * inputs are scanned in blocks that carry the same overlap.
+ */
+class SignatureScanner {
+public:
+    /**
+     * @brief Construct a scanner
+     * @param options Configuration options (signatures gives the file)
+     * @param formatter Formatter used to render the previews
+     * @param sink Destination of the hit lines
+     * @throws std::invalid_argument if the signatures file is malformed
+     */
+    SignatureScanner(const Options& options, const Formatter& formatter, OutputSink& sink);
+
+    /**
+     * @brief Scan the input and write the hits
+     * @param fd Open input, positioned at its beginning
+     * @return 0 if a signature was found, 1 if not, 2 on errors
+     */
+    int run(int fd);
+
+private:
+    /**
+     * @brief One chunk of a parallel scan
+     */
+    struct ChunkSlot {
+        std::uint64_t offset = 0;           // first byte of the chunk
+        std::uint64_t end = 0;              // first byte past the chunk (hits start before it)
+        std::vector<std::byte> input;       // chunk bytes plus the overlap
+        std::size_t input_size = 0;         // bytes read into input
+        std::vector<SignatureSet::Hit> hits;
+        std::vector<char> output;           // rendered hit lines
+        std::size_t output_size = 0;        // characters used in output
+        int error = 0;                      // errno of a failed read
+    };
+
+    const Options& options_;
+    const Formatter& formatter_;
+    OutputSink& sink_;
+    SignatureSet signatures_;
+    std::size_t overlap_;                   // bytes read past a block for its last hits and previews
+    std::vector<std::uint8_t> marks_;       // longest() ones followed by bytes_per_line zeros
+
+    /**
+     * @brief Maximum size of one rendered hit line
+     */
+    std::size_t max_hit_size() const;
+
+    /**
+     * @brief Render one hit line
+     * @param data Block the hit was found in
+     * @param offset Offset of data[0]
+     * @param hit Hit to render
+     * @param out Destination with room for max_hit_size() characters
+     * @return Pointer one past the last character written
+     */
+    char* render_hit(std::span<const std::byte> data, std::uint64_t offset,
+                     const SignatureSet::Hit& hit, char* out) const;
+
+    /**
+     * @brief Read, scan and render one chunk (runs on a worker thread)
+     * @param fd Open input
+     * @param end First byte past the scanned range
+     * @param slot Chunk to fill; offset and end are set by the caller
+     */
+    void scan_chunk(int fd, std::uint64_t end, ChunkSlot& slot) const;
+
+    /**
+     * @brief Scan a seekable input in chunks on a thread pool
+     * @param fd Open input
+     * @param end First byte past the scanned range
+     * @param found Set when there is a hit
+     * @return 0 for success, 2 on errors
+     */
+    int run_parallel(int fd, std::uint64_t end, bool& found);
+
+    /**
+     * @brief Scan an input in consecutive blocks
+     * @param fd Input positioned at its beginning
+     * @param found Set when there is a hit
+     * @return 0 for success, 2 on errors
+     */
+    int run_streamed(int fd, bool& found);
+};
+
+} // namespace hexview
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Vectorized hex encoding and decoding, printable classification, comparison, byte swapping and search with runtime dispatch
+namespace hexview {
+
+/**
+ * @brief Instruction set level of the selected kernels
+ */
+enum class SimdLevel {
+    Scalar,
+    SSE2,
+    SSSE3,
+    AVX2,
+    AVX512BW,
+};
+
+/**
+ * @brief Extra characters a kernel may store past the end of its output
+ *
+ * Spread kernels always store whole 16-byte vectors, so destination buffers
+ * need this much slack after the last character they keep.
+ */
+constexpr std::size_t SIMD_STORE_SLACK = 64;
+
+/**
+ * @brief Shuffle plan that spreads 16 hex pairs into hex-column cells
+ *
+ * Every byte becomes its two hex digits followed by one space, plus one more
+ * space after the last byte of each group, matching the Formatter layout.
+ * Only groups that divide 16 produce the same plan for every 16-byte block.
+ */
+struct HexSpread {
+    std::size_t group = 0;              // 0 => layout cannot be vectorized
+    std::size_t out_size = 0;           // characters produced per 16 input bytes
+    alignas(16) std::array<std::uint8_t, 64> from_low{};   // pshufb control over pair chars 0..15
+    alignas(16) std::array<std::uint8_t, 64> from_high{};  // pshufb control over pair chars 16..31
+    alignas(16) std::array<std::uint8_t, 64> fill{};       // ' ' where the output is a separator
+};
+
+/**
+ * @brief Build the spread plan for a byte grouping
+ * @param group Bytes per group
+ * @return Plan with group == 0 when 16 is not a multiple of group
+ */
+HexSpread make_hex_spread(std::size_t group);
+
+/**
+ * @brief Table of kernels selected for the running CPU
+ */
+struct HexKernels {
+    SimdLevel level;
+
+    /**
+     * @brief Encode bytes as contiguous hex pairs
+     * @param in Input bytes
+     * @param count Number of input bytes
+     * @param out Destination for 2 * count characters
+     * @param uppercase Whether to use uppercase letters
+     */
+    void (*encode_hex)(const unsigned char* in, std::size_t count, char* out, bool uppercase);
+
+    /**
+     * @brief Encode 16-byte blocks as spaced hex-column cells
+     * @param in Input bytes (blocks * 16 of them)
+     * @param blocks Number of 16-byte blocks
+     * @param out Destination for blocks * spread.out_size characters plus SIMD_STORE_SLACK
+     * @param uppercase Whether to use uppercase letters
+     * @param spread Plan from make_hex_spread()
+     * @return Pointer one past the last character kept
+     */
+    char* (*encode_hex_spread)(const unsigned char* in, std::size_t blocks, char* out,
+                               bool uppercase, const HexSpread& spread);
+
+    /**
+     * @brief Classify up to 64 bytes as printable ASCII
+     * @param in Input bytes
+     * @param count Number of input bytes (at most 64)
+     * @return Bit i set when in[i] is printable (32-126)
+     */
+    std::uint64_t (*classify_printable)(const unsigned char* in, std::size_t count);
+
+    /**
+     * @brief Copy printable bytes and replace the others
+     * @param in Input bytes
+     * @param count Number of input bytes
+     * @param out Destination for count characters
+     * @param substitute Character used for non-printable bytes
+     */
+    void (*map_ascii)(const unsigned char* in, std::size_t count, char* out, char substitute);
+
+    /**
+     * @brief Find the first position where two byte ranges differ
+     * @param a First range
+     * @param b Second range
+     * @param count Number of bytes in each range
+     * @return Index of the first differing byte, count if the ranges are equal
+     */
+    std::size_t (*mismatch)(const unsigned char* a, const unsigned char* b, std::size_t count);
+
+    /**
+     * @brief Decode contiguous hex pairs into bytes
+     * @param in 2 * count hex digits (either case)
+     * @param count Number of output bytes
+     * @param out Destination for count bytes
+     * @return false if any character is not a hex digit (out is then unspecified)
+     */
+    bool (*decode_hex)(const char* in, std::size_t count, unsigned char* out);
+
+    /**
+     * @brief Reverse the byte order of every word
+     * @param in Input bytes
+     * @param count Number of input bytes (a multiple of word)
+     * @param out Destination for count bytes (must not overlap in)
+     * @param word Word size in bytes: 2, 4 or 8
+     */
+    void (*swap_bytes)(const unsigned char* in, std::size_t count, unsigned char* out, std::size_t word);
+
+    /**
+     * @brief Find the first position holding one byte value with another a fixed distance after it
+     * @param in Input bytes; count + gap of them must be readable
+     * @param count Number of candidate positions
+     * @param first Byte wanted at in[i]
+     * @param second Byte wanted at in[i + gap]
+     * @param gap Distance between the two bytes (0 looks for first alone)
+     * @return Index of the first candidate position, count if there is none
+     */
+    std::size_t (*find_pair)(const unsigned char* in, std::size_t count, unsigned char first,
+                             unsigned char second, std::size_t gap);
+};
+
+/**
+ * @brief Get the kernels for the best instruction set this CPU supports
+ *
+ * Selected once with __builtin_cpu_supports. The HEXVIEW_SIMD environment
+ * variable (scalar, sse2, ssse3, avx2, avx512bw) caps the level.
+ */
+const HexKernels& hex_kernels();
+
+/**
+ * @brief Get a printable name for a SIMD level
+ */
+const char* simd_level_name(SimdLevel level);
+
+} // namespace hexview
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace hexview {
+
+/**
+ * @brief Bounded lock-free queue for exactly one producer and one consumer thread
+ *
+ * Positions only ever grow; the producer publishes with a release store of
+ * the tail and the consumer with a release store of the head. Blocking
+ * push()/pop() sleep on the other side's position with std::atomic::wait.
+ * @tparam T Trivially copyable element type
+ * @tparam CAPACITY Number of slots (a power of two)
+ */
+template <typename T, std::size_t CAPACITY>
+class SpscRing {
+    static_assert(CAPACITY != 0 && (CAPACITY & (CAPACITY - 1)) == 0, "ring capacity must be a power of two");
+
+public:
+    /**
+     * @brief Append an element if there is room (producer only)
+     * @param item Element to append
+     * @return false if the ring is full
+     */
+    bool try_push(const T& item) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == CAPACITY) return false;
+        items_[tail & (CAPACITY - 1)] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        tail_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element if there is one (consumer only)
+     * @param item Receives the element
+     * @return false if the ring is empty
+     */
+    bool try_pop(T& item) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+        item = items_[head & (CAPACITY - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        head_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Append an element, waiting for room (producer only)
+     * @param item Element to append
+     */
+    void push(const T& item) {
+        while (!try_push(item)) {
+            const std::size_t head = head_.load(std::memory_order_acquire);
+            if (tail_.load(std::memory_order_relaxed) - head == CAPACITY) {
+                head_.wait(head, std::memory_order_acquire);
+            }
+        }
+    }
+
+    /**
+     * @brief Remove the oldest element, waiting for one (consumer only)
+     * @return The element
+     */
+    T pop() {
+        T item{};
+        while (!try_pop(item)) {
+            const std::size_t tail = tail_.load(std::memory_order_acquire);
+            if (tail == head_.load(std::memory_order_relaxed)) {
+                tail_.wait(tail, std::memory_order_acquire);
+            }
+        }
+        return item;
+    }
+
+private:
+    alignas(64) std::atomic<std::size_t> head_{0};  // next element to pop
+    alignas(64) std::atomic<std::size_t> tail_{0};  // next free slot
+    alignas(64) std::array<T, CAPACITY> items_{};
+};
+
+} // namespace hexview
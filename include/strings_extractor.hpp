@@ -0,0 +1,92 @@
+#pragma once
+
+#include "options.hpp"
+#include "formatter.hpp"
+#include "output_sink.hpp"
+#include "simd_kernels.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hexview {
+
+/**
+ * @brief Lists the printable strings of an input (--strings)
+ *
+ * Printable means is_printable_ascii() (32-126). Each 64-byte word of
+ * input is classified with the vectorized classify_printable kernel and
+ * runs are walked with bit scans over the mask, so binary stretches cost
+ * one kernel call per word. With --utf16, characters are printable bytes
+ * followed by a zero byte; they are found with a zero-byte mask and
+ * chained into runs separately for even and odd offsets. A run still open
+ * at the end of a read block continues into the next one. Each run of at
+ * least the minimum length becomes one line with its offset in the
+ * configured offset format, in offset order.
+ */
+class StringsExtractor {
+public:
+    /**
+     * @brief Construct an extractor
+     * @param options Configuration options (strings gives the minimum length)
+     * @param formatter Formatter used to render the lines
+     * @param sink Destination of the lines
+     */
+    StringsExtractor(const Options& options, const Formatter& formatter, OutputSink& sink);
+
+    /**
+     * @brief Read an input to its end and write its strings
+     * @param fd Input file descriptor (positioned at its beginning)
+     * @return 0 for success, error code otherwise
+     */
+    int run(int fd);
+
+private:
+    /**
+     * @brief A string being collected
+     */
+    struct Run {
+        std::uint64_t start = 0;            // offset of the first character
+        std::uint64_t next = 0;             // offset the next UTF-16 character must have
+        std::string text;
+        bool active = false;
+    };
+
+    /**
+     * @brief A complete string waiting to be written
+     */
+    struct Found {
+        std::uint64_t start;
+        std::string text;
+    };
+
+    const Options& options_;
+    const Formatter& formatter_;
+    OutputSink& sink_;
+    const HexKernels& kernels_;
+    Run ascii_;
+    std::array<Run, 2> wide_;               // UTF-16LE runs at even and odd offsets
+    std::vector<Found> found_;
+
+    /**
+     * @brief Scan bytes for strings
+     * @param data Buffer holding the bytes
+     * @param count Number of bytes to scan
+     * @param available Bytes in the buffer (one past count may be looked at)
+     * @param offset Offset of data[0]
+     */
+    void scan(const unsigned char* data, std::size_t count, std::size_t available, std::uint64_t offset);
+
+    /**
+     * @brief Close a run, keeping it if it is long enough
+     */
+    void finish(Run& run);
+
+    /**
+     * @brief Write the complete strings in offset order
+     */
+    void emit();
+};
+
+} // namespace hexview
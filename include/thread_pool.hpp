@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hexview {
+
+/**
+ * @brief Fixed-size work-stealing thread pool
+ *
+ * Every worker owns a task deque. Tasks submitted from outside the pool are
+ * spread round-robin over the deques, tasks submitted by a worker go to its
+ * own deque. A worker takes from the back of its own deque and, when that is
+ * empty, steals from the front of the others.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Start the worker threads
+     * @param threads Number of workers (at least one is started)
+     */
+    explicit ThreadPool(std::size_t threads);
+
+    /**
+     * @brief Run all queued tasks, then stop and join the workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queue a task for execution
+     * @param task Callable to run on a worker thread
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Number of worker threads
+     */
+    std::size_t size() const { return threads_.size(); }
+
+private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<TaskQueue>> queues_;
+    std::vector<std::thread> threads_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::size_t pending_ = 0;          // queued tasks, guarded by wake_mutex_
+    bool stopping_ = false;            // guarded by wake_mutex_
+    std::atomic<std::size_t> next_queue_{0};
+
+    /**
+     * @brief Main loop of a worker thread
+     * @param index Index of the worker's own queue
+     */
+    void worker_loop(std::size_t index);
+
+    /**
+     * @brief Take a task from the worker's own queue or steal one
+     * @param index Index of the worker's own queue
+     * @param task Receives the task
+     * @return true if a task was taken
+     */
+    bool take_task(std::size_t index, std::function<void()>& task);
+};
+
+} // namespace hexview
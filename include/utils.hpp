@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <span>
 #include <string>
+#include <string_view>
 
 namespace hexview {
 
@@ -13,6 +17,17 @@ namespace hexview {
  */
 std::uint64_t parse_uint64(const std::string& s);
 
+/**
+ * @brief Copy text into a render buffer
+ * @param out Destination with room for the text
+ * @param text Characters to copy
+ * @return Pointer one past the last character written
+ */
+inline char* append(char* out, std::string_view text) {
+    std::memcpy(out, text.data(), text.size());
+    return out + text.size();
+}
+
 /**
  * @brief Convert value to hex string with specified width
  * @param value Value to convert
@@ -46,4 +61,102 @@ bool is_printable_ascii(unsigned char ch);
  */
 std::string escape_byte(unsigned char ch, bool show_escapes, bool ascii_dot_if_not);
 
-} // namespace hexview
\ No newline at end of file
+/**
+ * @brief Half-open range of input offsets
+ */
+struct ByteRange {
+    std::uint64_t begin = 0;
+    std::uint64_t end = 0;
+};
+
+/**
+ * @brief Size of a seekable input
+ * @param fd Open file descriptor
+ * @return Size of a regular file or block device, 0 for anything else
+ */
+std::uint64_t seekable_size(int fd);
+
+/**
+ * @brief Clamp a start/length selection to the input size
+ * @param size Input size
+ * @param start First byte wanted
+ * @param length Number of bytes wanted (0 = to the end)
+ * @return First byte past the selection (start when it lies beyond the input)
+ */
+std::uint64_t range_end(std::uint64_t size, std::uint64_t start, std::uint64_t length);
+
+/**
+ * @brief Read from a file descriptor, retrying when interrupted
+ * @param fd File descriptor to read
+ * @param data Destination buffer
+ * @param size Maximum number of bytes to read
+ * @return Bytes read, 0 at end of input, -1 on error (errno is set)
+ */
+long read_some(int fd, std::byte* data, std::size_t size);
+
+/**
+ * @brief Skip bytes from the current position of an input
+ *
+ * Seekable inputs are moved with lseek(); pipes are drained into /dev/null
+ * with splice() where available, otherwise with raw reads into scratch.
+ * @param fd Input file descriptor
+ * @param count Number of bytes to skip
+ * @param scratch Buffer for discarded reads
+ * @return Number of bytes skipped (less than count if the input ended)
+ */
+std::uint64_t skip_input(int fd, std::uint64_t count, std::span<std::byte> scratch);
+
+/**
+ * @brief Read bytes at an offset, retrying short reads
+ *
+ * Uses pread(), so threads can share the descriptor; not available on
+ * Windows, where it fails with ENOSYS.
+ * @param fd Seekable file descriptor
+ * @param data Destination buffer
+ * @param size Number of bytes wanted
+ * @param offset File offset of the first byte
+ * @param error Receives errno on failure (left alone otherwise)
+ * @return Number of bytes read (less than size at end of file or on error)
+ */
+std::size_t read_at(int fd, std::byte* data, std::size_t size, std::uint64_t offset, int& error);
+
+/**
+ * @brief Skip an input to the start offset, warning when stdin ends before it
+ *
+ * Seekable inputs that are too short are not warned about: they simply
+ * have nothing to show.
+ * @param fd Input file descriptor
+ * @param start Number of bytes to skip
+ * @param from_stdin Whether the input is stdin ("-")
+ * @param scratch Buffer for discarded reads
+ * @return true if the whole offset was skipped
+ */
+bool skip_to_start(int fd, std::uint64_t start, bool from_stdin, std::span<std::byte> scratch);
+
+/**
+ * @brief Read until a buffer is full or the input ends
+ *
+ * Short reads from pipes are continued, so only the last block of an
+ * input comes back short.
+ * @param fd File descriptor to read
+ * @param data Destination buffer
+ * @param size Number of bytes wanted
+ * @param error Receives errno of a failed read (left alone otherwise)
+ * @return Bytes read (less than size at end of input or on error)
+ */
+std::size_t read_full(int fd, std::byte* data, std::size_t size, int& error);
+
+/**
+ * @brief Find the next whole lines that lie inside a hole of a sparse file
+ *
+ * Holes are located with lseek(SEEK_HOLE/SEEK_DATA), so none of their
+ * bytes are read. Holes shorter than two lines are ignored.
+ * @param fd Open regular file (its file position is changed)
+ * @param from First byte to look at; lines start here and every bytes_per_line after
+ * @param end First byte past the dumped range
+ * @param bytes_per_line Line size
+ * @return Lines inside the next hole, or an empty range at end when there is none
+ */
+ByteRange find_hole_lines(int fd, std::uint64_t from, std::uint64_t end, std::size_t bytes_per_line);
+
+} // namespace hexview
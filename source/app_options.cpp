@@ -32,6 +32,7 @@ void AppOptions::show_usage(const std::string& program_name) const {
     std::cout << "  " << program_name << " file.bin\n";
     std::cout << "  " << program_name << " -n 8 -g 2 -u -c off file.bin\n";
     std::cout << "  cat file.bin | " << program_name << " -\n";
+    std::cout << "  " << program_name << " -r --output file.bin dump.txt\n";
 }
 
 bool AppOptions::has_option(std::string_view flag) const {
@@ -76,8 +77,8 @@ void AppOptions::parse_options(std::vector<std::string_view>& args) {
     for (auto it = args.begin(); it != args.end(); ++it) {
         auto flag = *it;
 
-        // Handle positional arguments (non-options)
-        if (!starts_with(flag, "-")) {
+        // Handle positional arguments (non-options); a lone "-" names stdin
+        if (flag == "-" || !starts_with(flag, "-")) {
             positional_args_.push_back(std::string(flag));
             continue;
         }
@@ -0,0 +1,236 @@
+#include "block_index.hpp"
+#include "checksum.hpp"
+#include "config.hpp"
+#include "entropy_analyzer.hpp"
+#include "thread_pool.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace hexview {
+
+namespace {
+
+constexpr std::uint64_t INDEX_MAGIC = 0x3130584449565848ull;   // "HXVIDX01" in file order
+constexpr std::uint64_t INDEX_VERSION = 1;
+constexpr std::size_t HEADER_WORDS = 8;
+
+static_assert(sizeof(BlockIndex::Entry) == 16, "index entries are stored as they are laid out in memory");
+
+/**
+ * @brief Summarize one block
+ */
+BlockIndex::Entry summarize(const unsigned char* data, std::size_t size) {
+    BlockIndex::Entry entry;
+    entry.hash = xxh64(data, size);
+
+    ByteHistogram histogram{};
+    count_bytes(data, size, histogram);
+    if (histogram[data[0]] == size) {
+        entry.value = data[0];
+        entry.flags = BlockIndex::UNIFORM;
+        if (entry.value == 0x00) entry.flags |= BlockIndex::ZERO;
+        if (entry.value == 0xFF) entry.flags |= BlockIndex::ONES;
+    }
+    const double entropy = histogram_entropy(histogram, size);
+    entry.entropy = static_cast<std::uint8_t>(std::min<long>(255, std::lround(entropy * 32.0)));
+    entry.text = static_cast<std::uint8_t>((count_text(histogram) * 255 + size / 2) / size);
+    return entry;
+}
+
+} // namespace
+
+std::string BlockIndex::sidecar_path(const std::string& filename) {
+    return filename + ".hvidx";
+}
+
+bool BlockIndex::same_fill(const Entry& a, const Entry& b) {
+    return (a.flags & UNIFORM) != 0 && (b.flags & UNIFORM) != 0 && a.value == b.value;
+}
+
+bool BlockIndex::open(const std::string& filename, const std::string& path, bool allow_build, std::size_t threads) {
+#if defined(_WIN32) || defined(_WIN64)
+    (void)filename;
+    (void)path;
+    (void)threads;
+    if (allow_build) std::cerr << "Error: block indexes are not supported on this platform\n";
+    return false;
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Error: failed to open file '" << filename << "'\n";
+        return false;
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        if (allow_build) std::cerr << "Error: only regular files can be indexed\n";
+        ::close(fd);
+        return false;
+    }
+
+    FileIdentity identity;
+    identity.size = static_cast<std::uint64_t>(st.st_size);
+#if defined(__APPLE__)
+    identity.mtime_sec = static_cast<std::uint64_t>(st.st_mtimespec.tv_sec);
+    identity.mtime_nsec = static_cast<std::uint64_t>(st.st_mtimespec.tv_nsec);
+#else
+    identity.mtime_sec = static_cast<std::uint64_t>(st.st_mtim.tv_sec);
+    identity.mtime_nsec = static_cast<std::uint64_t>(st.st_mtim.tv_nsec);
+#endif
+    identity.inode = static_cast<std::uint64_t>(st.st_ino);
+    identity.device = static_cast<std::uint64_t>(st.st_dev);
+    block_size_ = INDEX_BLOCK_SIZE;
+    file_size_ = identity.size;
+
+    bool ready = load(path, identity);
+    if (!ready && allow_build) {
+        ready = build(fd, threads);
+        if (ready && !save(path, identity)) {
+            std::cerr << "Warning: could not write index '" << path << "': " << std::strerror(errno) << "\n";
+        }
+    }
+    ::close(fd);
+    return ready;
+#endif
+}
+
+bool BlockIndex::load(const std::string& path, const FileIdentity& identity) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    std::uint64_t header[HEADER_WORDS];
+    if (!in.read(reinterpret_cast<char*>(header), sizeof(header))) return false;
+    const std::uint64_t expected[HEADER_WORDS] = {
+        INDEX_MAGIC, INDEX_VERSION, block_size_, identity.size,
+        identity.mtime_sec, identity.mtime_nsec, identity.inode, identity.device,
+    };
+    if (!std::equal(header, header + HEADER_WORDS, expected)) return false;
+
+    entries_.resize(static_cast<std::size_t>((file_size_ + block_size_ - 1) / block_size_));
+    const auto bytes = static_cast<std::streamsize>(entries_.size() * sizeof(Entry));
+    if (!in.read(reinterpret_cast<char*>(entries_.data()), bytes) || in.peek() != std::ifstream::traits_type::eof()) {
+        entries_.clear();
+        return false;
+    }
+    return true;
+}
+
+bool BlockIndex::build(int fd, std::size_t threads) {
+#if defined(_WIN32) || defined(_WIN64)
+    (void)fd;
+    (void)threads;
+    return false;
+#else
+    const std::uint64_t count = (file_size_ + block_size_ - 1) / block_size_;
+    entries_.assign(static_cast<std::size_t>(count), Entry{});
+
+    // Workers take runs of blocks in turn; entries are disjoint, so no ordering is needed
+    std::atomic<std::uint64_t> next{0};
+    std::atomic<int> error{0};
+    std::atomic<std::uint64_t> error_offset{0};
+    {
+        ThreadPool pool(threads);
+        for (std::size_t worker = 0; worker < pool.size(); ++worker) {
+            pool.submit([this, fd, count, &next, &error, &error_offset] {
+                std::vector<std::byte> buffer(static_cast<std::size_t>(INDEX_CHUNK_BLOCKS * block_size_));
+                for (;;) {
+                    const std::uint64_t first = next.fetch_add(INDEX_CHUNK_BLOCKS);
+                    if (first >= count || error.load() != 0) return;
+
+                    const std::uint64_t offset = first * block_size_;
+                    const auto want = static_cast<std::size_t>(std::min<std::uint64_t>(buffer.size(), file_size_ - offset));
+                    int read_error = 0;
+                    if (read_at(fd, buffer.data(), want, offset, read_error) != want) {
+                        error_offset = offset;
+                        error = read_error != 0 ? read_error : EIO;
+                        return;
+                    }
+
+                    const auto* bytes = reinterpret_cast<const unsigned char*>(buffer.data());
+                    for (std::size_t pos = 0; pos < want; pos += block_size_) {
+                        const std::size_t size = std::min<std::size_t>(block_size_, want - pos);
+                        entries_[first + pos / block_size_] = summarize(bytes + pos, size);
+                    }
+                }
+            });
+        }
+    } // the pool joins its workers here
+
+    if (error != 0) {
+        std::cerr << "Error: failed to read input near offset " << error_offset.load() << " while indexing: "
+                  << std::strerror(error.load()) << "\n";
+        entries_.clear();
+        return false;
+    }
+    return true;
+#endif
+}
+
+bool BlockIndex::save(const std::string& path, const FileIdentity& identity) const {
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        const std::uint64_t header[HEADER_WORDS] = {
+            INDEX_MAGIC, INDEX_VERSION, block_size_, identity.size,
+            identity.mtime_sec, identity.mtime_nsec, identity.inode, identity.device,
+        };
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(entries_.data()),
+                  static_cast<std::streamsize>(entries_.size() * sizeof(Entry)));
+        if (!out.flush()) {
+            const int saved = errno;
+            std::remove(temporary.c_str());
+            errno = saved;
+            return false;
+        }
+    }
+    // Readers see either the old index or the complete new one
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+std::uint64_t BlockIndex::next_data(std::uint64_t offset) const {
+    for (std::uint64_t b = offset / block_size_; b < entries_.size(); ++b) {
+        if ((entries_[b].flags & UNIFORM) == 0) return std::max(offset, b * block_size_);
+    }
+    return std::max(offset, file_size_);
+}
+
+BlockIndex::UniformLines BlockIndex::find_uniform_lines(std::uint64_t from, std::uint64_t end,
+                                                        std::size_t bytes_per_line) const {
+    end = std::min(end, file_size_);
+    const std::uint64_t count = entries_.size();
+    for (std::uint64_t b = from / block_size_; b < count && b * block_size_ < end;) {
+        if ((entries_[b].flags & UNIFORM) == 0) {
+            ++b;
+            continue;
+        }
+        std::uint64_t e = b + 1;
+        while (e < count && e * block_size_ < end && same_fill(entries_[b], entries_[e])) ++e;
+
+        // Whole lines of the run, on the line grid that starts at from
+        const std::uint64_t run_begin = std::max(from, b * block_size_);
+        const std::uint64_t run_end = std::min(end, e * block_size_);
+        const std::uint64_t first = from + (run_begin - from + bytes_per_line - 1) / bytes_per_line * bytes_per_line;
+        const std::uint64_t last = from + (run_end - from) / bytes_per_line * bytes_per_line;
+        if (last > first && last - first >= 2 * bytes_per_line) {
+            return { { first, last }, entries_[b].value };
+        }
+        b = e;
+    }
+    return { { end, end }, 0 };
+}
+
+} // namespace hexview
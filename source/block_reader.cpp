@@ -0,0 +1,255 @@
+#include "block_reader.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cerrno>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+namespace hexview {
+
+BlockReader::~BlockReader() {
+#if !defined(_WIN32) && !defined(_WIN64)
+    if (reader_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        changed_.notify_all();
+        reader_.join();
+    }
+
+    // The kernel may still be writing into the buffers
+    while (use_ring_ && in_flight_ != 0 && ring_.submit(1)) {
+        std::uint64_t user_data = 0;
+        std::int32_t result = 0;
+        while (ring_.reap(user_data, result)) --in_flight_;
+    }
+
+    if (buffers_ != nullptr) ::munmap(buffers_, buffers_size_);
+    if (fd_ >= 0) ::close(fd_);
+#endif
+}
+
+bool BlockReader::open(const std::string& path, std::uint64_t start, std::uint64_t length,
+                       std::size_t block_size, std::size_t depth) {
+#if defined(_WIN32) || defined(_WIN64)
+    (void)path;
+    (void)start;
+    (void)length;
+    (void)block_size;
+    (void)depth;
+    return false;
+#else
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) return false;
+
+    const std::uint64_t size = seekable_size(fd_);
+    if (size == 0) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    start_ = start;
+    position_ = start;
+    end_ = range_end(size, start, length);
+    block_size_ = block_size;
+    blocks_ = (end_ - start_ + block_size_ - 1) / block_size_;
+    depth = std::max<std::size_t>(2, depth);
+    slots_.resize(depth);
+
+    // One block more than the slots stays zero for blocks inside holes
+    buffers_size_ = (depth + 1) * block_size_;
+    void* mem = ::mmap(nullptr, buffers_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        buffers_ = nullptr;
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    buffers_ = static_cast<std::byte*>(mem);
+    zeros_ = buffers_ + depth * block_size_;
+
+#  if defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(fd_, static_cast<off_t>(start_), static_cast<off_t>(end_ - start_), POSIX_FADV_SEQUENTIAL);
+#  endif
+
+    use_ring_ = ring_.setup(static_cast<unsigned>(depth));
+    if (use_ring_) {
+        // Plain reads still work when registration is refused (RLIMIT_MEMLOCK)
+        ring_.register_buffers(buffers_, block_size_, static_cast<unsigned>(depth));
+        while (queued_ < blocks_ && queued_ < depth) queue_block();
+        if (!ring_.submit(0)) {
+            error_ = errno;
+            stopped_ = true;
+        }
+    } else {
+        reader_ = std::thread([this] { read_ahead(); });
+    }
+    return true;
+#endif
+}
+
+bool BlockReader::in_hole(std::uint64_t offset, std::size_t size) {
+    if (hole_.end <= offset) hole_ = find_hole_lines(fd_, offset, end_, 1);
+    return hole_.begin <= offset && offset + size <= hole_.end;
+}
+
+void BlockReader::queue_block() {
+    Slot& slot = slots_[queued_ % slots_.size()];
+    slot.offset = start_ + queued_ * block_size_;
+    slot.size = static_cast<std::size_t>(std::min<std::uint64_t>(block_size_, end_ - slot.offset));
+    slot.filled = 0;
+    slot.error = 0;
+    slot.hole = in_hole(slot.offset, slot.size);
+    slot.done = false;
+
+    const std::size_t index = queued_ % slots_.size();
+    if (slot.hole) {
+        slot.filled = slot.size;
+        slot.done = true;
+    } else if (ring_.queue_read(fd_, slot_data(index), slot.size, slot.offset,
+                                static_cast<unsigned>(index), index)) {
+        ++in_flight_;
+    } else {
+        slot.error = EAGAIN;
+        slot.done = true;
+    }
+    ++queued_;
+}
+
+bool BlockReader::wait_ring(Slot& slot) {
+    while (!slot.done) {
+        std::uint64_t index = 0;
+        std::int32_t result = 0;
+        if (!ring_.reap(index, result)) {
+            if (!ring_.submit(1)) return false;
+            continue;
+        }
+        --in_flight_;
+
+        Slot& finished = slots_[static_cast<std::size_t>(index)];
+        if (result < 0) {
+            finished.error = -result;
+            finished.done = true;
+        } else if (result == 0) {
+            finished.done = true; // file shrank since open()
+        } else {
+            finished.filled += static_cast<std::size_t>(result);
+            if (finished.filled == finished.size) {
+                finished.done = true;
+            } else if (ring_.queue_read(fd_, slot_data(static_cast<std::size_t>(index)) + finished.filled,
+                                        finished.size - finished.filled, finished.offset + finished.filled,
+                                        static_cast<unsigned>(index), index)) {
+                // Short read: ask for the rest
+                ++in_flight_;
+                if (!ring_.submit(0)) return false;
+            } else {
+                finished.error = EAGAIN;
+                finished.done = true;
+            }
+        }
+    }
+    return true;
+}
+
+void BlockReader::read_ahead() {
+#if !defined(_WIN32) && !defined(_WIN64)
+    for (std::uint64_t block = 0; block < blocks_; ++block) {
+        Slot& slot = slots_[block % slots_.size()];
+        {
+            // Wait until the caller has released the block that used this slot
+            std::unique_lock<std::mutex> lock(mutex_);
+            changed_.wait(lock, [&] { return stopping_ || block < next_block_ + slots_.size(); });
+            if (stopping_) return;
+        }
+
+        const std::uint64_t offset = start_ + block * block_size_;
+        const std::size_t size = static_cast<std::size_t>(std::min<std::uint64_t>(block_size_, end_ - offset));
+        std::byte* data = slot_data(block % slots_.size());
+        const bool hole = in_hole(offset, size);
+        std::size_t filled = hole ? size : 0;
+        int error = 0;
+        while (filled < size) {
+            ssize_t n = ::pread(fd_, data + filled, size - filled, static_cast<off_t>(offset + filled));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                error = errno;
+                break;
+            }
+            if (n == 0) break; // file shrank since open()
+            filled += static_cast<std::size_t>(n);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            slot.offset = offset;
+            slot.size = size;
+            slot.filled = filled;
+            slot.error = error;
+            slot.hole = hole;
+            slot.done = true;
+        }
+        changed_.notify_all();
+        if (error != 0 || filled != size) return;
+    }
+#endif
+}
+
+std::span<const std::byte> BlockReader::next() {
+    if (held_) {
+        held_ = false;
+        if (use_ring_) {
+            slots_[next_block_ % slots_.size()].done = false;
+            ++next_block_;
+            if (!stopped_ && queued_ < blocks_) {
+                queue_block();
+                if (!ring_.submit(0)) {
+                    error_ = errno;
+                    stopped_ = true;
+                }
+            }
+        } else {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                slots_[next_block_ % slots_.size()].done = false;
+                ++next_block_;
+            }
+            changed_.notify_all();
+        }
+    }
+
+    if (stopped_ || next_block_ >= blocks_) return {};
+
+    const std::size_t index = next_block_ % slots_.size();
+    Slot& slot = slots_[index];
+    if (use_ring_) {
+        if (!wait_ring(slot)) {
+            error_ = errno;
+            stopped_ = true;
+            return {};
+        }
+    } else {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [&slot] { return slot.done; });
+    }
+
+    if (slot.error != 0) {
+        error_ = slot.error;
+        stopped_ = true;
+        return {};
+    }
+    // A short block is the last one
+    if (slot.filled != slot.size) stopped_ = true;
+    if (slot.filled == 0) return {};
+
+    held_ = true;
+    position_ = slot.offset + slot.filled;
+    return { slot.hole ? zeros_ : slot_data(index), slot.filled };
+}
+
+} // namespace hexview
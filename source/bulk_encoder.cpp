@@ -0,0 +1,101 @@
+#include "bulk_encoder.hpp"
+#include "render_tables.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <string_view>
+
+namespace hexview {
+
+BulkEncoder::BulkEncoder(const Options& options, OutputSink& sink)
+    : options_(options),
+      sink_(sink),
+      kernels_(hex_kernels()),
+      c_bytes_(options.uppercase ? C_BYTES_UPPER.data() : C_BYTES_LOWER.data()) {
+    const std::size_t BPL = options_.bytes_per_line;
+    if (options_.style == Options::Style::Include) {
+        // ",\n" ending the previous row, two spaces of indent, "0xHH, " per
+        // byte and room for the padding of the last 8-byte store
+        row_size_ = 2 + 2 + 6 * BPL + 2;
+    } else {
+        row_size_ = 2 * BPL + 1 + SIMD_STORE_SLACK;
+    }
+
+    // The array is named after the file the way xxd does it
+    if (options_.filename != "-") {
+        for (char ch : options_.filename) {
+            name_ += std::isalnum(static_cast<unsigned char>(ch)) ? ch : '_';
+        }
+        if (!name_.empty() && std::isdigit(static_cast<unsigned char>(name_[0]))) name_.insert(0, "__");
+    }
+}
+
+void BulkEncoder::begin() {
+    started_ = true;
+    if (options_.style != Options::Style::Include || name_.empty()) return;
+    sink_.write("unsigned char ");
+    sink_.write(name_);
+    sink_.write("[] = {\n");
+}
+
+char* BulkEncoder::render_row(const unsigned char* bytes, std::size_t count, char* out) {
+    if (options_.style == Options::Style::Plain) {
+        kernels_.encode_hex(bytes, count, out, options_.uppercase);
+        out += 2 * count;
+        *out++ = '\n';
+        return out;
+    }
+
+    // The last row ends without a comma, so each row finishes the one before it
+    if (total_ != 0) {
+        *out++ = ',';
+        *out++ = '\n';
+    }
+    *out++ = ' ';
+    *out++ = ' ';
+    for (std::size_t i = 0; i < count; ++i) {
+        std::memcpy(out, c_bytes_ + 8 * bytes[i], 8);
+        out += 6;
+    }
+    total_ += count;
+    return out - 2; // drop the ", " after the last byte
+}
+
+void BulkEncoder::encode_rows(std::span<const std::byte> data) {
+    if (!started_) begin();
+
+    const std::size_t BPL = options_.bytes_per_line;
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+    std::size_t rows = data.size() / BPL;
+    const std::size_t batch = std::max<std::size_t>(1, sink_.capacity() / row_size_);
+
+    while (rows != 0) {
+        const std::size_t n = std::min(rows, batch);
+        char* out = sink_.reserve(n * row_size_);
+        for (std::size_t i = 0; i < n; ++i, bytes += BPL) {
+            out = render_row(bytes, BPL, out);
+        }
+        sink_.commit(out);
+        rows -= n;
+    }
+}
+
+void BulkEncoder::finish(std::span<const std::byte> partial) {
+    if (!started_) begin();
+
+    if (!partial.empty()) {
+        char* out = sink_.reserve(row_size_);
+        sink_.commit(render_row(reinterpret_cast<const unsigned char*>(partial.data()), partial.size(), out));
+    }
+    if (options_.style != Options::Style::Include) return;
+
+    if (total_ != 0) sink_.write("\n");
+    if (name_.empty()) return;
+    sink_.write("};\nunsigned int ");
+    sink_.write(name_);
+    sink_.write("_len = ");
+    sink_.write(std::to_string(total_));
+    sink_.write(";\n");
+}
+
+} // namespace hexview
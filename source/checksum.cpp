@@ -0,0 +1,261 @@
+#include "checksum.hpp"
+#include "simd_kernels.hpp"
+#include <array>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#  define HEXVIEW_CRC32C_HARDWARE 1
+#  include <immintrin.h>
+#endif
+
+namespace hexview {
+
+namespace {
+
+constexpr std::uint32_t CRC32C_POLY = 0x82F63B78u;     // Castagnoli polynomial, bit-reflected
+
+/**
+ * @brief Little-endian loads (compilers merge the shifts into one load)
+ */
+std::uint64_t load64(const unsigned char* in) {
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < 8; ++i) value |= std::uint64_t{in[i]} << (8 * i);
+    return value;
+}
+
+std::uint32_t load32(const unsigned char* in) {
+    std::uint32_t value = 0;
+    for (std::size_t i = 0; i < 4; ++i) value |= std::uint32_t{in[i]} << (8 * i);
+    return value;
+}
+
+using CrcTables = std::array<std::array<std::uint32_t, 256>, 8>;
+
+/**
+ * @brief Slicing-by-8 tables: tables[k][b] is the CRC of byte b followed by k zero bytes
+ */
+constexpr CrcTables make_crc_tables() {
+    CrcTables tables{};
+    for (std::uint32_t b = 0; b < 256; ++b) {
+        std::uint32_t crc = b;
+        for (int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ ((crc & 1) != 0 ? CRC32C_POLY : 0);
+        tables[0][b] = crc;
+    }
+    for (std::size_t k = 1; k < 8; ++k) {
+        for (std::size_t b = 0; b < 256; ++b) {
+            const std::uint32_t prev = tables[k - 1][b];
+            tables[k][b] = (prev >> 8) ^ tables[0][prev & 0xFF];
+        }
+    }
+    return tables;
+}
+
+constexpr CrcTables CRC_TABLES = make_crc_tables();
+
+/**
+ * @brief Advance a CRC register over bytes without the pre- and post-inversion
+ */
+std::uint32_t crc32c_scalar(std::uint32_t crc, const unsigned char* in, std::size_t count) {
+    for (; count >= 8; in += 8, count -= 8) {
+        const std::uint32_t lo = load32(in) ^ crc;
+        const std::uint32_t hi = load32(in + 4);
+        crc = CRC_TABLES[7][lo & 0xFF] ^ CRC_TABLES[6][(lo >> 8) & 0xFF] ^
+              CRC_TABLES[5][(lo >> 16) & 0xFF] ^ CRC_TABLES[4][lo >> 24] ^
+              CRC_TABLES[3][hi & 0xFF] ^ CRC_TABLES[2][(hi >> 8) & 0xFF] ^
+              CRC_TABLES[1][(hi >> 16) & 0xFF] ^ CRC_TABLES[0][hi >> 24];
+    }
+    for (; count != 0; ++in, --count) crc = (crc >> 8) ^ CRC_TABLES[0][(crc ^ *in) & 0xFF];
+    return crc;
+}
+
+#if defined(HEXVIEW_CRC32C_HARDWARE)
+
+// Each of the three streams covers this many bytes of a long or short group
+constexpr std::size_t CRC_LONG = 8192;
+constexpr std::size_t CRC_SHORT = 256;
+
+using Gf2Matrix = std::array<std::uint32_t, 32>;   // column i is the image of bit i
+using ShiftTables = std::array<std::array<std::uint32_t, 256>, 4>;
+
+std::uint32_t gf2_times(const Gf2Matrix& matrix, std::uint32_t vector) {
+    std::uint32_t sum = 0;
+    for (std::size_t i = 0; vector != 0; ++i, vector >>= 1) {
+        if ((vector & 1) != 0) sum ^= matrix[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief Tables that advance a CRC register over a run of zero bytes
+ *
+ * Appending zeros is linear in the register, so its effect is a 32x32
+ * matrix over GF(2); the matrix for one zero bit is raised to the run
+ * length by squaring, then applied to every value of each register byte.
+ */
+ShiftTables make_shift_tables(std::size_t length) {
+    Gf2Matrix power{};
+    power[0] = CRC32C_POLY;
+    for (std::size_t i = 1; i < 32; ++i) power[i] = std::uint32_t{1} << (i - 1);
+
+    Gf2Matrix shift{};
+    for (std::size_t i = 0; i < 32; ++i) shift[i] = std::uint32_t{1} << i;
+    for (std::uint64_t bits = std::uint64_t{length} * 8; bits != 0; bits >>= 1) {
+        Gf2Matrix next{};
+        if ((bits & 1) != 0) {
+            for (std::size_t i = 0; i < 32; ++i) next[i] = gf2_times(power, shift[i]);
+            shift = next;
+        }
+        for (std::size_t i = 0; i < 32; ++i) next[i] = gf2_times(power, power[i]);
+        power = next;
+    }
+
+    ShiftTables tables{};
+    for (std::size_t k = 0; k < 4; ++k) {
+        for (std::uint32_t b = 0; b < 256; ++b) tables[k][b] = gf2_times(shift, b << (8 * k));
+    }
+    return tables;
+}
+
+std::uint32_t shift_crc(const ShiftTables& tables, std::uint64_t crc) {
+    return tables[0][crc & 0xFF] ^ tables[1][(crc >> 8) & 0xFF] ^
+           tables[2][(crc >> 16) & 0xFF] ^ tables[3][(crc >> 24) & 0xFF];
+}
+
+/**
+ * @brief Hash groups of three equal streams, then join their registers
+ * @return Register after the groups; in and count are advanced past them
+ */
+template <std::size_t STREAM>
+__attribute__((target("sse4.2")))
+std::uint64_t crc32c_streams(std::uint64_t crc, const unsigned char*& in, std::size_t& count,
+                             const ShiftTables& shift) {
+    for (; count >= 3 * STREAM; in += 3 * STREAM, count -= 3 * STREAM) {
+        std::uint64_t crc1 = 0;
+        std::uint64_t crc2 = 0;
+        for (std::size_t i = 0; i < STREAM; i += 8) {
+            std::uint64_t a;
+            std::uint64_t b;
+            std::uint64_t c;
+            std::memcpy(&a, in + i, 8);
+            std::memcpy(&b, in + STREAM + i, 8);
+            std::memcpy(&c, in + 2 * STREAM + i, 8);
+            crc = _mm_crc32_u64(crc, a);
+            crc1 = _mm_crc32_u64(crc1, b);
+            crc2 = _mm_crc32_u64(crc2, c);
+        }
+        // The register of A|B is A's shifted over STREAM zeros xor B's from zero
+        crc = shift_crc(shift, crc) ^ crc1;
+        crc = shift_crc(shift, crc) ^ crc2;
+    }
+    return crc;
+}
+
+__attribute__((target("sse4.2")))
+std::uint32_t crc32c_sse42(std::uint32_t initial, const unsigned char* in, std::size_t count) {
+    static const ShiftTables long_shift = make_shift_tables(CRC_LONG);
+    static const ShiftTables short_shift = make_shift_tables(CRC_SHORT);
+
+    std::uint64_t crc = initial;
+    crc = crc32c_streams<CRC_LONG>(crc, in, count, long_shift);
+    crc = crc32c_streams<CRC_SHORT>(crc, in, count, short_shift);
+    for (; count >= 8; in += 8, count -= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, in, 8);
+        crc = _mm_crc32_u64(crc, word);
+    }
+    auto crc32 = static_cast<std::uint32_t>(crc);
+    for (; count != 0; ++in, --count) crc32 = _mm_crc32_u8(crc32, *in);
+    return crc32;
+}
+
+#endif // HEXVIEW_CRC32C_HARDWARE
+
+using CrcFunction = std::uint32_t (*)(std::uint32_t, const unsigned char*, std::size_t);
+
+CrcFunction select_crc32c() {
+#if defined(HEXVIEW_CRC32C_HARDWARE)
+    // HEXVIEW_SIMD=scalar turns off every vector and CRC instruction
+    __builtin_cpu_init();
+    if (hex_kernels().level != SimdLevel::Scalar && __builtin_cpu_supports("sse4.2")) return crc32c_sse42;
+#endif
+    return crc32c_scalar;
+}
+
+const CrcFunction CRC32C_SELECTED = select_crc32c();
+
+constexpr std::uint64_t XXH_PRIME1 = 0x9E3779B185EBCA87ull;
+constexpr std::uint64_t XXH_PRIME2 = 0xC2B2AE3D27D4EB4Full;
+constexpr std::uint64_t XXH_PRIME3 = 0x165667B19E3779F9ull;
+constexpr std::uint64_t XXH_PRIME4 = 0x85EBCA77C2B2AE63ull;
+constexpr std::uint64_t XXH_PRIME5 = 0x27D4EB2F165667C5ull;
+
+std::uint64_t xxh_round(std::uint64_t acc, std::uint64_t input) {
+    acc += input * XXH_PRIME2;
+    acc = std::rotl(acc, 31);
+    return acc * XXH_PRIME1;
+}
+
+std::uint64_t xxh_merge(std::uint64_t acc, std::uint64_t lane) {
+    acc ^= xxh_round(0, lane);
+    return acc * XXH_PRIME1 + XXH_PRIME4;
+}
+
+} // namespace
+
+std::uint32_t crc32c(const unsigned char* in, std::size_t count) {
+    return ~CRC32C_SELECTED(~std::uint32_t{0}, in, count);
+}
+
+bool crc32c_hardware() {
+    return CRC32C_SELECTED != crc32c_scalar;
+}
+
+std::uint64_t xxh64(const unsigned char* in, std::size_t count, std::uint64_t seed) {
+    const unsigned char* const end = in + count;
+    std::uint64_t hash;
+
+    if (count >= 32) {
+        std::uint64_t v1 = seed + XXH_PRIME1 + XXH_PRIME2;
+        std::uint64_t v2 = seed + XXH_PRIME2;
+        std::uint64_t v3 = seed;
+        std::uint64_t v4 = seed - XXH_PRIME1;
+        for (; end - in >= 32; in += 32) {
+            v1 = xxh_round(v1, load64(in));
+            v2 = xxh_round(v2, load64(in + 8));
+            v3 = xxh_round(v3, load64(in + 16));
+            v4 = xxh_round(v4, load64(in + 24));
+        }
+        hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+        hash = xxh_merge(hash, v1);
+        hash = xxh_merge(hash, v2);
+        hash = xxh_merge(hash, v3);
+        hash = xxh_merge(hash, v4);
+    } else {
+        hash = seed + XXH_PRIME5;
+    }
+    hash += count;
+
+    for (; end - in >= 8; in += 8) {
+        hash ^= xxh_round(0, load64(in));
+        hash = std::rotl(hash, 27) * XXH_PRIME1 + XXH_PRIME4;
+    }
+    if (end - in >= 4) {
+        hash ^= std::uint64_t{load32(in)} * XXH_PRIME1;
+        hash = std::rotl(hash, 23) * XXH_PRIME2 + XXH_PRIME3;
+        in += 4;
+    }
+    for (; in < end; ++in) {
+        hash ^= std::uint64_t{*in} * XXH_PRIME5;
+        hash = std::rotl(hash, 11) * XXH_PRIME1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= XXH_PRIME2;
+    hash ^= hash >> 29;
+    hash *= XXH_PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+} // namespace hexview
@@ -0,0 +1,124 @@
+#include "checksum_dumper.hpp"
+#include "checksum.hpp"
+#include "config.hpp"
+#include "ordered_chunks.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+
+namespace hexview {
+
+namespace {
+
+constexpr std::size_t ANNOTATE_BATCH_LINES = 256;   // dump lines rendered per sink reservation
+
+} // namespace
+
+ChecksumDumper::ChecksumDumper(const Options& options, const Formatter& formatter, OutputSink& sink)
+    : options_(options),
+      formatter_(formatter),
+      sink_(sink),
+      chunk_size_(std::max(options.checksum_block, CHECKSUM_CHUNK_SIZE / options.checksum_block * options.checksum_block)),
+      digits_(options.checksum == Options::Checksum::Crc32c ? 8 : 16) {}
+
+void ChecksumDumper::hash_chunk(ChunkSlot& slot) const {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(slot.input.data());
+    const std::size_t block = options_.checksum_block;
+    slot.hashes.clear();
+    for (std::size_t pos = 0; pos < slot.size; pos += block) {
+        const std::size_t count = std::min(block, slot.size - pos);
+        slot.hashes.push_back(options_.checksum == Options::Checksum::Crc32c ? crc32c(bytes + pos, count)
+                                                                             : xxh64(bytes + pos, count));
+    }
+}
+
+char* ChecksumDumper::render_hash(std::uint64_t hash, char* out) const {
+    const char* hex = options_.uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    for (std::size_t i = digits_; i-- > 0;) {
+        out[i] = hex[hash & 0xF];
+        hash >>= 4;
+    }
+    return out + digits_;
+}
+
+void ChecksumDumper::write_list(const ChunkSlot& slot) {
+    const std::size_t line_size = formatter_.text_line_size(digits_);
+    char digits[16];
+    for (std::size_t i = 0; i < slot.hashes.size(); ++i) {
+        const std::string_view text(digits, static_cast<std::size_t>(render_hash(slot.hashes[i], digits) - digits));
+        char* out = sink_.reserve(line_size);
+        sink_.commit(formatter_.render_text_line(slot.offset + i * options_.checksum_block, text, out));
+    }
+}
+
+void ChecksumDumper::write_annotated(const ChunkSlot& slot) {
+    const std::size_t BPL = options_.bytes_per_line;
+    const std::size_t block = options_.checksum_block;
+    const std::size_t line_size = formatter_.max_line_size() + 2 + digits_;
+    const std::size_t batch = ANNOTATE_BATCH_LINES * BPL;
+    for (std::size_t first = 0; first < slot.size; first += batch) {
+        const std::size_t last = std::min(slot.size, first + batch);
+        char* out = sink_.reserve(ANNOTATE_BATCH_LINES * line_size);
+        for (std::size_t pos = first; pos < last; pos += BPL) {
+            const std::size_t count = std::min(BPL, last - pos);
+            out = formatter_.render_line(std::span<const std::byte>(slot.input.data() + pos, count), slot.offset + pos, out);
+
+            // Blocks are whole lines, so a block ends with a line or with the input
+            const std::size_t end = pos + count;
+            if (end % block == 0 || end == slot.size) {
+                --out;  // the checksum goes in front of the newline
+                *out++ = ' ';
+                *out++ = ' ';
+                out = render_hash(slot.hashes[(end - 1) / block], out);
+                *out++ = '\n';
+            }
+        }
+        sink_.commit(out);
+    }
+}
+
+int ChecksumDumper::run(int fd) {
+    OrderedChunks<ChunkSlot> chunks(options_.threads);
+    for (ChunkSlot& slot : chunks.slots()) slot.input.resize(chunk_size_);
+
+    skip_to_start(fd, options_.start, options_.filename == "-", chunks.slots()[0].input);
+
+    std::uint64_t offset = options_.start;     // offset of the next chunk
+    std::uint64_t remaining = options_.length; // 0 => unlimited
+    const bool limited = options_.length != 0;
+    bool eof = false;
+    int rc = 0;
+
+    // Fill a whole chunk, so only the last one can end with a short block
+    auto read_chunk = [&](ChunkSlot& slot) {
+        if (eof) return false;
+        std::size_t want = chunk_size_;
+        if (limited && remaining < want) want = static_cast<std::size_t>(remaining);
+        int error = 0;
+        slot.offset = offset;
+        slot.size = read_full(fd, slot.input.data(), want, error);
+        if (error != 0) {
+            std::cerr << "Error: failed to read input at offset " << offset + slot.size << ": "
+                      << std::strerror(error) << "\n";
+            rc = 1;
+        }
+        if (limited) remaining -= slot.size;
+        eof = slot.size < want || (limited && remaining == 0);
+        offset += slot.size;
+        return slot.size != 0;
+    };
+
+    chunks.run(read_chunk,
+               [this](ChunkSlot& slot) { hash_chunk(slot); },
+               [this](const ChunkSlot& slot) {
+                   if (options_.annotate) write_annotated(slot);
+                   else write_list(slot);
+                   return sink_.good();
+               });
+    return rc;
+}
+
+} // namespace hexview
@@ -20,13 +20,22 @@ Color::Color(bool enabled) : enabled_(enabled) {}
 
 void Color::set(Code code) const {
     if (!enabled_) return;
+    std::cout << sequence(code);
+}
+
+std::string_view Color::sequence(Code code) const {
+    if (!enabled_) return {};
 
     switch (code) {
-        case Code::BrightYellow: std::cout << "\x1b[1;33m"; break;
-        case Code::BrightGreen:  std::cout << "\x1b[1;32m"; break;
-        case Code::BrightWhite:  std::cout << "\x1b[1;37m"; break;
-        case Code::Reset:        std::cout << "\x1b[0m";    break;
+        case Code::BrightYellow: return "\x1b[1;33m";
+        case Code::BrightGreen:  return "\x1b[1;32m";
+        case Code::BrightWhite:  return "\x1b[1;37m";
+        case Code::BrightRed:    return "\x1b[1;31m";
+        case Code::BrightBlue:   return "\x1b[1;34m";
+        case Code::BrightCyan:   return "\x1b[1;36m";
+        case Code::Reset:        return "\x1b[0m";
     }
+    return {};
 }
 
 void Color::reset() const {
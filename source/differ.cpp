@@ -0,0 +1,229 @@
+#include "differ.hpp"
+#include "config.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+#if defined(_WIN32) || defined(_WIN64)
+#  include <io.h>
+#  include <fcntl.h>
+#  define FILENO_STDIN _fileno(stdin)
+#else
+#  include <cstdio>
+#  include <fcntl.h>
+#  include <unistd.h>
+#  define FILENO_STDIN fileno(stdin)
+#endif
+
+namespace hexview {
+
+DiffInput::~DiffInput() {
+    if (!owns_fd_) return;
+#if defined(_WIN32) || defined(_WIN64)
+    _close(fd_);
+#else
+    ::close(fd_);
+#endif
+}
+
+bool DiffInput::open(const std::string& path, std::uint64_t start, std::uint64_t length, std::size_t block_size) {
+    block_size_ = block_size;
+    offset_ = start;
+
+    // Regular files and block devices are compared straight from a mapping
+    if (path != "-" && mapped_.open(path, start, length)) {
+        use_map_ = true;
+        end_ = mapped_.end();
+        return true;
+    }
+
+    if (path == "-") {
+        fd_ = FILENO_STDIN;
+#if defined(_WIN32) || defined(_WIN64)
+        _setmode(fd_, _O_BINARY);
+#endif
+    } else {
+#if defined(_WIN32) || defined(_WIN64)
+        fd_ = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+        fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+        if (fd_ < 0) return false;
+        owns_fd_ = true;
+    }
+
+    buffer_.resize(block_size_);
+    // An input shorter than the start offset is simply empty
+    if (start != 0) skip_input(fd_, start, buffer_);
+    limited_ = length != 0;
+    remaining_ = length;
+    return true;
+}
+
+std::span<const std::byte> DiffInput::next() {
+    if (use_map_) {
+        if (offset_ >= end_) return {};
+        const auto size = static_cast<std::size_t>(std::min<std::uint64_t>(block_size_, end_ - offset_));
+        if (offset_ + size > window_offset_ + window_.size()) {
+            // Sliding windows of large ranges; small ranges are mapped once
+            window_ = mapped_.map_window(offset_, size);
+            window_offset_ = offset_;
+            if (window_.size() < size) {
+                error_ = errno != 0 ? errno : EIO;
+                return {};
+            }
+        }
+        std::span<const std::byte> block = window_.subspan(static_cast<std::size_t>(offset_ - window_offset_), size);
+        offset_ += size;
+        return block;
+    }
+
+    std::size_t want = block_size_;
+    if (limited_ && remaining_ < want) want = static_cast<std::size_t>(remaining_);
+
+    // Fill the block completely so short pipe reads do not misalign the inputs
+    std::size_t got = 0;
+    while (got < want) {
+        long n = read_some(fd_, buffer_.data() + got, want - got);
+        if (n < 0) {
+            error_ = errno;
+            return {};
+        }
+        if (n == 0) break;
+        got += static_cast<std::size_t>(n);
+    }
+    if (limited_) remaining_ -= got;
+    return { buffer_.data(), got };
+}
+
+Differ::Differ(const Options& options, const Formatter& formatter, OutputSink& sink)
+    : options_(options),
+      formatter_(formatter),
+      sink_(sink),
+      kernels_(hex_kernels()) {}
+
+void Differ::emit_marker(std::string_view label, std::uint64_t begin, std::uint64_t end) {
+    char* out = sink_.reserve(formatter_.max_line_size());
+    sink_.commit(formatter_.render_marker(label, begin, end, out));
+}
+
+void Differ::emit_identical(std::uint64_t end) {
+    if (end > same_from_) emit_marker("identical", same_from_, end);
+    same_from_ = std::max(same_from_, end);
+}
+
+void Differ::emit_lines(std::span<const std::byte> a, std::span<const std::byte> b, std::uint64_t offset) {
+    emit_identical(offset);
+    same_from_ = offset + options_.bytes_per_line;
+
+    // A byte is highlighted when it differs or the other line does not have it
+    const std::size_t BPL = options_.bytes_per_line;
+    marks_.resize(2 * BPL);
+    for (std::size_t i = 0; i < BPL; ++i) {
+        const bool differs = i >= a.size() || i >= b.size() || a[i] != b[i];
+        marks_[i] = marks_[BPL + i] = differs ? 1 : 0;
+    }
+    const std::span<const std::uint8_t> marks_a(marks_.data(), a.size());
+    const std::span<const std::uint8_t> marks_b(marks_.data() + BPL, b.size());
+
+    char* out = sink_.reserve(2 * formatter_.max_line_size() + 4);
+    if (options_.side_by_side) {
+        // Short lines are padded to the full width, so the right side stays aligned
+        out = formatter_.render_marked_line(a, marks_a, offset, out);
+        out[-1] = ' ';
+        *out++ = '|';
+        *out++ = ' ';
+        out = formatter_.render_marked_line(b, marks_b, offset, out);
+    } else {
+        *out++ = '-';
+        out = formatter_.render_marked_line(a, marks_a, offset, out);
+        *out++ = '+';
+        out = formatter_.render_marked_line(b, marks_b, offset, out);
+    }
+    sink_.commit(out);
+}
+
+int Differ::run() {
+    const std::size_t BPL = options_.bytes_per_line;
+    // Blocks hold whole lines, so a line never straddles two blocks
+    const std::size_t block_size = std::max(BPL, DIFF_BLOCK_SIZE - DIFF_BLOCK_SIZE % BPL);
+
+    DiffInput a;
+    DiffInput b;
+    for (auto [input, name] : { std::pair{ &a, &options_.filename }, std::pair{ &b, &options_.diff_filename } }) {
+        if (!input->open(*name, options_.start, options_.length, block_size)) {
+            std::cerr << "Error: failed to open file '" << *name << "': " << std::strerror(errno) << "\n";
+            return 2;
+        }
+    }
+
+    sink_.write("--- " + options_.filename + "\n+++ " + options_.diff_filename + "\n");
+
+    std::uint64_t offset = options_.start;     // offset of the current blocks
+    same_from_ = offset;
+    bool differ = false;
+    for (;;) {
+        const std::span<const std::byte> da = a.next();
+        const std::span<const std::byte> db = b.next();
+        if (a.error() != 0 || b.error() != 0) {
+            const bool first = a.error() != 0;
+            std::cerr << "Error: failed to read '" << (first ? options_.filename : options_.diff_filename)
+                      << "' at offset " << offset << ": " << std::strerror(first ? a.error() : b.error()) << "\n";
+            return 2;
+        }
+
+        // Jump from difference to difference; identical stretches are one kernel call
+        const std::size_t common = std::min(da.size(), db.size());
+        const auto* pa = reinterpret_cast<const unsigned char*>(da.data());
+        const auto* pb = reinterpret_cast<const unsigned char*>(db.data());
+        for (std::size_t pos = 0; pos < common;) {
+            pos += kernels_.mismatch(pa + pos, pb + pos, common - pos);
+            if (pos == common) break;
+            const std::size_t line = pos - pos % BPL;
+            emit_lines(da.subspan(line, std::min(BPL, da.size() - line)),
+                       db.subspan(line, std::min(BPL, db.size() - line)), offset + line);
+            differ = true;
+            pos = line + BPL;
+        }
+
+        if (da.size() == db.size()) {
+            if (da.empty()) break;
+            offset += da.size();
+            continue;
+        }
+
+        // One input ends in this block: its last partial line differs, the rest exists in one input only
+        differ = true;
+        const std::size_t line = common - common % BPL;
+        if (common % BPL != 0 && offset + line >= same_from_) {
+            emit_lines(da.subspan(line, std::min(BPL, da.size() - line)),
+                       db.subspan(line, std::min(BPL, db.size() - line)), offset + line);
+        }
+        const std::uint64_t tail_begin = offset + line + (common % BPL != 0 ? BPL : 0);
+        emit_identical(tail_begin);
+
+        const bool first_longer = da.size() > db.size();
+        DiffInput& longer = first_longer ? a : b;
+        std::uint64_t tail_end = offset + std::max(da.size(), db.size());
+        for (std::span<const std::byte> rest = longer.next(); !rest.empty(); rest = longer.next()) {
+            tail_end += rest.size();
+        }
+        if (longer.error() != 0) {
+            std::cerr << "Error: failed to read '" << (first_longer ? options_.filename : options_.diff_filename)
+                      << "' at offset " << tail_end << ": " << std::strerror(longer.error()) << "\n";
+            return 2;
+        }
+        if (tail_end > tail_begin) {
+            emit_marker(first_longer ? "only in first" : "only in second", tail_begin, tail_end);
+        }
+        return 1;
+    }
+    emit_identical(offset);
+
+    return differ ? 1 : 0;
+}
+
+} // namespace hexview
@@ -1,134 +1,595 @@
 #include "dumper.hpp"
 #include "config.hpp"
+#include "block_index.hpp"
+#include "checksum_dumper.hpp"
 #include "color.hpp"
-#include <fstream>
+#include "differ.hpp"
+#include "entropy_analyzer.hpp"
+#include "finder.hpp"
+#include "pager.hpp"
+#include "parallel_dumper.hpp"
+#include "pipeline.hpp"
+#include "reverser.hpp"
+#include "signature_scanner.hpp"
+#include "strings_extractor.hpp"
+#include "utils.hpp"
 #include <iostream>
-#include <array>
 #include <vector>
 #include <algorithm>
+#include <charconv>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
 
 #if defined(_WIN32) || defined(_WIN64)
 #  include <io.h>
 #  include <fcntl.h>
+#  define FILENO_STDOUT _fileno(stdout)
+#  define FILENO_STDIN _fileno(stdin)
+#else
+#  include <cstdio>
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  define FILENO_STDOUT fileno(stdout)
+#  define FILENO_STDIN fileno(stdin)
 #endif
 
 namespace hexview {
 
 HexDumper::HexDumper(const Options& options) : options_(options) {
-    bool has_color_support = terminal_supports_color();
+    int out_fd = FILENO_STDOUT;
+    if (!options_.output.empty()) {
+#if defined(_WIN32) || defined(_WIN64)
+        output_fd_ = _open(options_.output.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, 0666);
+#else
+        output_fd_ = ::open(options_.output.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+#endif
+        if (output_fd_ < 0) output_error_ = errno;
+        out_fd = output_fd_;
+    }
+
+    // Dumps written to a file are never colored
+    bool has_color_support = options_.output.empty() && terminal_supports_color();
     color_ = std::make_unique<Color>(options_.color && has_color_support);
-    formatter_ = std::make_unique<Formatter>(options_, *color_);
+    sink_ = std::make_unique<OutputSink>(out_fd, options_.vmsplice);
+    formatter_ = std::make_unique<Formatter>(options_, *color_, *sink_);
+    // Pick a compile-time specialized layout once; other layouts stay generic
+    formatter_->use_fixed_layout();
+    if (options_.style != Options::Style::Dump) {
+        encoder_ = std::make_unique<BulkEncoder>(options_, *sink_);
+    } else if (options_.squeeze) {
+        squeezer_ = std::make_unique<LineSqueezer>(*formatter_, options_.bytes_per_line);
+    }
 }
 
-int HexDumper::run() {
-    return process_input();
+HexDumper::~HexDumper() {
+    if (output_fd_ < 0) return;
+    sink_.reset();
+#if defined(_WIN32) || defined(_WIN64)
+    _close(output_fd_);
+#else
+    ::close(output_fd_);
+#endif
 }
 
-int HexDumper::process_input() {
-    std::istream* in_ptr = nullptr;
-    std::ifstream file_stream;
+int HexDumper::run() {
+    if (!options_.output.empty() && output_fd_ < 0) {
+        std::cerr << "Error: failed to open output file '" << options_.output << "': "
+                  << std::strerror(output_error_) << "\n";
+        return 1;
+    }
 
-    if (options_.filename == "-") {
-#if defined(_WIN32) || defined(_WIN64)
-        _setmode(_fileno(stdin), _O_BINARY);
-#endif
-        in_ptr = &std::cin;
-        std::cin.sync_with_stdio(false);
-        std::cin.tie(nullptr);
-    } else {
-        file_stream.open(options_.filename, std::ios::binary);
-        if (!file_stream.is_open()) {
-            std::cerr << "Error: failed to open file '" << options_.filename << "'\n";
+    if (options_.index || options_.summary || options_.next_data) {
+        if (options_.filename == "-") {
+            std::cerr << "Error: --index, --summary and --next-data need a file, not stdin\n";
             return 1;
         }
-        in_ptr = &file_stream;
+        if (!load_index(true)) return 1;
+        if (options_.next_data) options_.start = index_->next_data(options_.start);
     }
 
-    std::istream& in = *in_ptr;
+    if (options_.reverse) {
+        return process_reverse();
+    }
 
-    // Seek to start if file is seekable and a file (not "-")
-    if (options_.filename != "-") {
-        if (options_.start != 0) {
-            file_stream.clear();
-            file_stream.seekg(static_cast<std::streamoff>(options_.start), std::ios::beg);
-            if (!file_stream.good()) {
-                std::cerr << "Error: seeking to start offset " << options_.start << " failed.\n";
-                return 2;
+    if (options_.diff) {
+        return process_diff();
+    }
+
+    // A --find pattern is the pager's first search
+    if (options_.interactive) {
+        return process_interactive();
+    }
+
+    if (!options_.find.empty()) {
+        return process_find();
+    }
+
+    if (!options_.signatures.empty()) {
+        return process_signatures();
+    }
+
+    if (options_.strings != 0) {
+        return process_strings();
+    }
+
+    if (options_.entropy != 0) {
+        return process_entropy();
+    }
+
+    if (options_.checksum != Options::Checksum::None) {
+        return process_checksum();
+    }
+
+    if (options_.summary) {
+        return process_summary();
+    }
+
+    // Huge files reuse an index left by an earlier --index run
+    if (!index_ && squeezer_ && options_.filename != "-") load_index(false);
+    // Runs of one repeated byte are squeezed straight from the index on the mapped path
+    const bool indexed = index_ && squeezer_;
+
+    // Plain and C include output always take the serial paths
+    if (options_.filename != "-" && options_.threads > 1 && !encoder_ && !indexed) {
+        // Seekable inputs are split into chunks rendered on a thread pool
+        ParallelDumper parallel(options_, *formatter_, *sink_);
+        if (parallel.open(options_.filename)) {
+            if (output_is_regular_file() && formatter_->fixed_line_size() && !options_.squeeze) {
+                // Every chunk's position is known, so workers write in place
+                return parallel.run_positional(output_fd_);
             }
+            int rc = parallel.run();
+            int flushed = finish_output();
+            return rc != 0 ? rc : flushed;
         }
-    } else {
-        if (options_.start != 0) {
-            std::uint64_t to_skip = options_.start;
-            std::array<char, 4096> skipbuf;
-            while (to_skip > 0 && in.good()) {
-                std::streamsize chunk = static_cast<std::streamsize>(
-                    std::min<std::uint64_t>(skipbuf.size(), to_skip));
-                in.read(skipbuf.data(), chunk);
-                std::streamsize got = in.gcount();
-                if (got <= 0) break;
-                to_skip -= static_cast<std::uint64_t>(got);
-            }
-            if (to_skip != 0) {
-                std::cerr << "Warning: could not skip to start offset; input too short.\n";
+    }
+
+    if (options_.pipeline && !encoder_ && !indexed) {
+        return process_pipeline();
+    }
+
+    if (options_.filename != "-") {
+        if (options_.queue_depth > 0 && !indexed) {
+            // Reads of the following blocks overlap formatting of the current one
+            const std::size_t BPL = options_.bytes_per_line;
+            const std::size_t block = std::max(BPL, READ_AHEAD_BLOCK_SIZE - READ_AHEAD_BLOCK_SIZE % BPL);
+            BlockReader reader;
+            if (reader.open(options_.filename, options_.start, options_.length, block, options_.queue_depth)) {
+                return process_blocks(reader);
             }
         }
+
+        // Regular files and block devices are rendered straight from a mapping
+        MappedInput mapped;
+        if (mapped.open(options_.filename, options_.start, options_.length)) {
+            return process_mapped(mapped);
+        }
     }
+    return process_input();
+}
 
+int HexDumper::process_mapped(MappedInput& input) {
     const std::size_t BPL = options_.bytes_per_line;
-    const std::size_t read_block = calculate_optimal_buffer_size(BPL);
+    const std::uint64_t end = input.end();
+    std::uint64_t offset = options_.start;
+    std::span<const std::byte> tail;
 
-    std::vector<unsigned char> line_buf;
-    line_buf.reserve(BPL);
+    // Lines inside holes of a sparse file are squeezed without being read
+    ByteRange hole{end, end};
+    if (squeezer_) hole = find_hole_lines(input.fd(), offset, end, BPL);
 
-    std::vector<unsigned char> buffer(read_block);
-    std::uint64_t offset = options_.start;
-    std::uint64_t remaining = options_.length; // 0 => unlimited
-    bool eof_reached = false;
+    // So are lines inside index blocks of one repeated byte
+    BlockIndex::UniformLines run{ { end, end }, 0 };
+    std::vector<std::byte> run_line(BPL);
+    auto find_run = [&] {
+        if (!squeezer_ || !index_) return;
+        run = index_->find_uniform_lines(offset, end, BPL);
+        if (run.lines.begin < hole.begin) run.lines.end = std::min(run.lines.end, hole.begin);
+    };
+    find_run();
+
+    while (offset < end) {
+        if (offset == hole.begin) {
+            char* out = sink_->reserve(formatter_->max_line_size());
+            sink_->commit(squeezer_->skip_hole(hole.begin, hole.end, out));
+            offset = hole.end;
+            hole = find_hole_lines(input.fd(), offset, end, BPL);
+            if (run.lines.begin < offset) find_run();
+            continue;
+        }
 
-    while (!eof_reached) {
-        std::streamsize want = static_cast<std::streamsize>(read_block);
-        if (remaining != 0) {
-            if (remaining < static_cast<std::uint64_t>(want)) {
-                want = static_cast<std::streamsize>(remaining);
+        if (offset == run.lines.begin) {
+            std::fill(run_line.begin(), run_line.end(), std::byte{run.value});
+            char* out = sink_->reserve(2 * formatter_->max_line_size());
+            sink_->commit(squeezer_->render_run(run_line, run.lines.begin, run.lines.end, out));
+            offset = run.lines.end;
+            if (hole.begin < offset) hole = find_hole_lines(input.fd(), offset, end, BPL);
+            find_run();
+            continue;
+        }
+
+        auto window = input.map_window(offset, BPL);
+        if (window.empty()) {
+            if (offset == options_.start) {
+                // Nothing rendered yet, so the streaming path can take over
+                return process_input();
             }
+            std::cerr << "Error: failed to map '" << options_.filename << "' at offset " << offset << "\n";
+            finish_output();
+            return 1;
+        }
+
+        const std::uint64_t skip = std::min(hole.begin, run.lines.begin);
+        if (window.size() > skip - offset) {
+            window = window.first(static_cast<std::size_t>(skip - offset));
         }
 
-        in.read(reinterpret_cast<char*>(buffer.data()), want);
-        std::streamsize got = in.gcount();
-        if (got <= 0) {
-            eof_reached = true;
+        std::size_t used = format_lines(window, offset);
+        offset += used;
+        // A partial line only remains at the end of the range
+        if (used != window.size() && offset + (window.size() - used) == end) {
+            tail = window.subspan(used);
             break;
         }
+    }
+
+    format_final_line(tail, offset);
+    return finish_output();
+}
+
+int HexDumper::open_input() const {
+    int fd = FILENO_STDIN;
+    if (options_.filename == "-") {
+#if defined(_WIN32) || defined(_WIN64)
+        _setmode(fd, _O_BINARY);
+#endif
+        return fd;
+    }
+#if defined(_WIN32) || defined(_WIN64)
+    fd = _open(options_.filename.c_str(), _O_RDONLY | _O_BINARY);
+#else
+    fd = ::open(options_.filename.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+    if (fd < 0) {
+        std::cerr << "Error: failed to open file '" << options_.filename << "'\n";
+    }
+    return fd;
+}
+
+void HexDumper::close_input(int fd) const {
+    if (fd == FILENO_STDIN) return;
+#if defined(_WIN32) || defined(_WIN64)
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+}
+
+int HexDumper::process_pipeline() {
+    int fd = open_input();
+    if (fd < 0) return 1;
+
+    int rc = Pipeline(options_, *formatter_, *sink_).run(fd);
+    close_input(fd);
+    int flushed = finish_output();
+    return rc != 0 ? rc : flushed;
+}
+
+int HexDumper::process_reverse() {
+    int fd = open_input();
+    if (fd < 0) return 1;
+
+    const int out_fd = output_fd_ >= 0 ? output_fd_ : FILENO_STDOUT;
+#if defined(_WIN32) || defined(_WIN64)
+    _setmode(out_fd, _O_BINARY);
+#endif
+
+    int rc = HexReverser(options_, out_fd).run(fd);
+    close_input(fd);
+    return rc;
+}
 
-        for (std::streamsize i = 0; i < got; ++i) {
-            unsigned char b = buffer[static_cast<std::size_t>(i)];
-            line_buf.push_back(b);
+int HexDumper::process_diff() {
+    int rc = Differ(options_, *formatter_, *sink_).run();
+    int flushed = finish_output();
+    return flushed != 0 ? 2 : rc;
+}
+
+int HexDumper::process_find() {
+    // A malformed pattern is reported before the input is opened
+    Finder finder(options_, *formatter_, *sink_);
+
+    int fd = open_input();
+    if (fd < 0) return 2;
+
+    int rc = finder.run(fd);
+    close_input(fd);
+    int flushed = finish_output();
+    return flushed != 0 ? 2 : rc;
+}
+
+int HexDumper::process_signatures() {
+    // A malformed signatures file is reported before the input is opened
+    SignatureScanner scanner(options_, *formatter_, *sink_);
+
+    int fd = open_input();
+    if (fd < 0) return 2;
+
+    int rc = scanner.run(fd);
+    close_input(fd);
+    int flushed = finish_output();
+    return flushed != 0 ? 2 : rc;
+}
+
+int HexDumper::process_strings() {
+    int fd = open_input();
+    if (fd < 0) return 1;
+
+    int rc = StringsExtractor(options_, *formatter_, *sink_).run(fd);
+    close_input(fd);
+    int flushed = finish_output();
+    return rc != 0 ? rc : flushed;
+}
+
+int HexDumper::process_entropy() {
+    int fd = open_input();
+    if (fd < 0) return 1;
+
+    int rc = EntropyAnalyzer(options_, *formatter_, *color_, *sink_).run(fd);
+    close_input(fd);
+    int flushed = finish_output();
+    return rc != 0 ? rc : flushed;
+}
+
+int HexDumper::process_checksum() {
+    int fd = open_input();
+    if (fd < 0) return 1;
+
+    int rc = ChecksumDumper(options_, *formatter_, *sink_).run(fd);
+    close_input(fd);
+    int flushed = finish_output();
+    return rc != 0 ? rc : flushed;
+}
+
+int HexDumper::process_blocks(BlockReader& reader) {
+    const std::size_t BPL = options_.bytes_per_line;
+    const std::uint64_t end = reader.end();
+    std::uint64_t offset = options_.start;
+    std::span<const std::byte> tail;
 
-            if (line_buf.size() == BPL) {
-                std::uint64_t first_byte_offset = offset - static_cast<std::uint64_t>(line_buf.size());
-                formatter_->format_line(line_buf, first_byte_offset);
-                line_buf.clear();
+    // Lines inside holes of a sparse file are squeezed; the reader skips their blocks
+    ByteRange hole{end, end};
+    if (squeezer_) hole = find_hole_lines(reader.fd(), offset, end, BPL);
+
+    for (auto block = reader.next(); !block.empty(); block = reader.next()) {
+        const std::uint64_t block_end = reader.position();
+        const std::uint64_t block_offset = block_end - block.size();
+        while (offset < block_end) {
+            if (offset == hole.begin) {
+                char* out = sink_->reserve(formatter_->max_line_size());
+                sink_->commit(squeezer_->skip_hole(hole.begin, hole.end, out));
+                offset = hole.end;
+                hole = find_hole_lines(reader.fd(), offset, end, BPL);
+                continue;
             }
 
-            offset++;
-            if (remaining != 0) {
-                if (remaining > 0) {
-                    remaining--;
-                    if (remaining == 0) {
-                        eof_reached = true;
-                        break;
-                    }
-                }
+            auto data = block.subspan(static_cast<std::size_t>(offset - block_offset),
+                                      static_cast<std::size_t>(std::min(block_end, hole.begin) - offset));
+            std::size_t used = format_lines(data, offset);
+            offset += used;
+            // Blocks and holes are whole lines, so a partial line only ends the range
+            if (used != data.size()) {
+                tail = data.subspan(used);
+                break;
             }
         }
     }
 
-    if (!line_buf.empty()) {
-        std::uint64_t first_byte_offset = offset - static_cast<std::uint64_t>(line_buf.size());
-        formatter_->format_line(line_buf, first_byte_offset);
+    if (reader.error() != 0) {
+        std::cerr << "Error: failed to read '" << options_.filename << "' at offset "
+                  << reader.position() << ": " << std::strerror(reader.error()) << "\n";
+        finish_output();
+        return 1;
+    }
+    format_final_line(tail, offset);
+    return finish_output();
+}
+
+int HexDumper::process_interactive() {
+    return Pager(options_, *formatter_).run();
+}
+
+bool HexDumper::load_index(bool allow_build) {
+#if !defined(_WIN32) && !defined(_WIN64)
+    if (!allow_build) {
+        // Looking for an index only pays off when the dump itself takes long
+        struct stat st {};
+        if (::stat(options_.filename.c_str(), &st) != 0 || !S_ISREG(st.st_mode) ||
+            static_cast<std::uint64_t>(st.st_size) <= HUGE_FILE_THRESHOLD) {
+            return false;
+        }
+    }
+#endif
+    const std::string path = options_.index_file.empty() ? BlockIndex::sidecar_path(options_.filename)
+                                                         : options_.index_file;
+    index_ = std::make_unique<BlockIndex>();
+    if (!index_->open(options_.filename, path, allow_build, options_.threads)) {
+        index_.reset();
+        return false;
+    }
+    return true;
+}
+
+int HexDumper::process_summary() {
+    const auto& entries = index_->entries();
+    const std::uint64_t block = index_->block_size();
+    const std::uint64_t end = options_.length != 0 ? std::min(index_->file_size(), options_.start + options_.length)
+                                                   : index_->file_size();
+    const char* hex = options_.uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+
+    // Blocks of one repeated byte are classed by that byte (256 + value), the others as in --entropy
+    enum : unsigned { TEXT, RANDOM, DATA, FILL = 256 };
+    auto classify = [](const BlockIndex::Entry& entry) -> unsigned {
+        if ((entry.flags & BlockIndex::UNIFORM) != 0) return FILL + entry.value;
+        if (std::size_t{entry.text} * 100 >= TEXT_PERCENT * 255) return TEXT;
+        if (entry.entropy >= RANDOM_ENTROPY * 32) return RANDOM;
+        return DATA;
+    };
+
+    std::uint64_t offset = options_.start;
+    while (offset < end && sink_->good()) {
+        // Extend the run over the following blocks of the same class
+        std::uint64_t b = offset / block;
+        const unsigned kind = classify(entries[b]);
+        const std::uint64_t run_begin = offset;
+        double entropy = 0;
+        double text = 0;
+        for (; b * block < end && classify(entries[b]) == kind; ++b) {
+            const std::uint64_t covered = std::min(end, (b + 1) * block) - std::max(run_begin, b * block);
+            entropy += static_cast<double>(entries[b].entropy) * static_cast<double>(covered);
+            text += static_cast<double>(entries[b].text) * static_cast<double>(covered);
+        }
+        offset = std::min(end, b * block);
+        const auto size = static_cast<double>(offset - run_begin);
+
+        // "zero     12345678 bytes  entropy 0.00  text   0%"
+        char line[64];
+        std::string_view name = kind == TEXT ? "text" : kind == RANDOM ? "random" : kind == DATA ? "data" : "zero";
+        char* s = line;
+        if (kind > FILL) {
+            s = std::copy_n("fill ", 5, s);
+            *s++ = hex[(kind - FILL) >> 4];
+            *s++ = hex[(kind - FILL) & 0xF];
+        } else {
+            s = std::copy(name.begin(), name.end(), s);
+        }
+        s = std::fill_n(s, 8 - (s - line), ' ');
+        char digits[20];
+        char* digits_end = std::to_chars(digits, digits + sizeof(digits), offset - run_begin).ptr;
+        s = std::fill_n(s, std::max<std::ptrdiff_t>(1, 16 - (digits_end - digits)), ' ');
+        s = std::copy(digits, digits_end, s);
+        s = std::copy_n(" bytes  entropy ", 16, s);
+        s = std::to_chars(s, s + 8, entropy / size / 32.0, std::chars_format::fixed, 2).ptr;
+        s = std::copy_n("  text ", 7, s);
+        const auto percent = static_cast<std::uint64_t>(std::lround(text / size / 255.0 * 100.0));
+        s = std::fill_n(s, percent >= 100 ? 0 : percent >= 10 ? 1 : 2, ' ');
+        s = std::to_chars(s, s + 3, percent).ptr;
+        *s++ = '%';
+
+        const std::string_view summary(line, static_cast<std::size_t>(s - line));
+        char* out = sink_->reserve(formatter_->text_line_size(summary.size()));
+        sink_->commit(formatter_->render_text_line(run_begin, summary, out));
     }
+    return finish_output();
+}
 
+std::size_t HexDumper::format_lines(std::span<const std::byte> data, std::uint64_t offset) {
+    const std::size_t BPL = options_.bytes_per_line;
+    const std::size_t whole = data.size() - data.size() % BPL;
+    if (encoder_) {
+        encoder_->encode_rows(data.first(whole));
+        return whole;
+    }
+    if (squeezer_) {
+        const std::size_t line_size = formatter_->max_line_size();
+        for (std::size_t pos = 0; pos < whole; pos += BPL) {
+            char* out = sink_->reserve(line_size);
+            sink_->commit(squeezer_->render(data.subspan(pos, BPL), offset + pos, out));
+        }
+        return whole;
+    }
+
+    for (std::size_t pos = 0; pos < whole; pos += BPL) {
+        formatter_->format_line(data.subspan(pos, BPL), offset + pos);
+    }
+    return whole;
+}
+
+void HexDumper::format_final_line(std::span<const std::byte> partial, std::uint64_t offset) {
+    if (encoder_) {
+        encoder_->finish(partial);
+        return;
+    }
+    if (!squeezer_) {
+        if (!partial.empty()) formatter_->format_line(partial, offset);
+        return;
+    }
+
+    char* out = sink_->reserve(formatter_->max_line_size());
+    if (!partial.empty()) {
+        out = squeezer_->render(partial, offset, out);
+    }
+    sink_->commit(squeezer_->finish(out));
+}
+
+bool HexDumper::output_is_regular_file() const {
+#if defined(_WIN32) || defined(_WIN64)
+    return false;
+#else
+    struct stat st {};
+    return output_fd_ >= 0 && ::fstat(output_fd_, &st) == 0 && S_ISREG(st.st_mode);
+#endif
+}
+
+int HexDumper::finish_output() {
+    if (!sink_->flush()) {
+        std::cerr << "Error: failed to write output\n";
+        return 1;
+    }
     return 0;
 }
 
+int HexDumper::process_input() {
+    int fd = open_input();
+    if (fd < 0) return 1;
+
+    const std::size_t BPL = options_.bytes_per_line;
+    const std::size_t read_block = calculate_optimal_buffer_size(BPL);
+
+    // A partial line left at the end of a block is moved to the front of the
+    // buffer and the next block is read right after it
+    std::vector<std::byte> buffer(BPL + read_block);
+
+    skip_to_start(fd, options_.start, options_.filename == "-", buffer);
+
+    std::size_t carry = 0;
+    std::uint64_t offset = options_.start;
+    std::uint64_t remaining = options_.length; // 0 => unlimited
+    const bool limited = options_.length != 0;
+    int rc = 0;
+
+    while (!limited || remaining != 0) {
+        std::size_t want = read_block;
+        if (limited && remaining < want) {
+            want = static_cast<std::size_t>(remaining);
+        }
+
+        long got = read_some(fd, buffer.data() + carry, want);
+        if (got < 0) {
+            std::cerr << "Error: failed to read input at offset " << offset + carry << ": "
+                      << std::strerror(errno) << "\n";
+            rc = 1;
+            break;
+        }
+        if (got == 0) break;
+        if (limited) remaining -= static_cast<std::uint64_t>(got);
+
+        std::span<const std::byte> block(buffer.data(), carry + static_cast<std::size_t>(got));
+        std::size_t used = format_lines(block, offset);
+        offset += used;
+        carry = block.size() - used;
+        if (carry != 0 && used != 0) {
+            std::memmove(buffer.data(), buffer.data() + used, carry);
+        }
+    }
+
+    format_final_line(std::span<const std::byte>(buffer.data(), carry), offset);
+    close_input(fd);
+
+    int flushed = finish_output();
+    return rc != 0 ? rc : flushed;
+}
+
 } // namespace hexview
\ No newline at end of file
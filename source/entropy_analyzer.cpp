@@ -0,0 +1,237 @@
+#include "entropy_analyzer.hpp"
+#include "config.hpp"
+#include "ordered_chunks.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace hexview {
+
+namespace {
+
+constexpr std::size_t BAR_WIDTH = 32;           // characters of the entropy bar
+constexpr std::size_t MAX_SUMMARY_SIZE = 96;    // summary text after the offset
+constexpr std::size_t XLOGX_TABLE_LIMIT = 65536; // largest block whose c * log2(c) terms are tabulated
+
+} // namespace
+
+void count_bytes(const unsigned char* in, std::size_t count, ByteHistogram& histogram) {
+    // Each table gets at most a quarter of a piece, so 32-bit counters do not overflow
+    constexpr std::size_t PIECE = std::size_t{1} << 30;
+    std::uint32_t tables[4][256];
+
+    while (count != 0) {
+        const std::size_t size = std::min(count, PIECE);
+        std::memset(tables, 0, sizeof(tables));
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            std::uint64_t x;
+            std::memcpy(&x, in + i, 8);
+            ++tables[0][x & 0xFF];
+            ++tables[1][(x >> 8) & 0xFF];
+            ++tables[2][(x >> 16) & 0xFF];
+            ++tables[3][(x >> 24) & 0xFF];
+            ++tables[0][(x >> 32) & 0xFF];
+            ++tables[1][(x >> 40) & 0xFF];
+            ++tables[2][(x >> 48) & 0xFF];
+            ++tables[3][x >> 56];
+        }
+        for (; i < size; ++i) ++tables[0][in[i]];
+
+        for (std::size_t b = 0; b < 256; ++b) {
+            histogram[b] += std::uint64_t{tables[0][b]} + tables[1][b] + tables[2][b] + tables[3][b];
+        }
+        in += size;
+        count -= size;
+    }
+}
+
+std::uint64_t count_text(const ByteHistogram& histogram) {
+    std::uint64_t text = histogram['\t'] + histogram['\n'] + histogram['\r'];
+    for (std::size_t b = 32; b <= 126; ++b) text += histogram[b];
+    return text;
+}
+
+double histogram_entropy(const ByteHistogram& histogram, std::uint64_t total, std::span<const double> xlogx) {
+    // H = log2(n) - sum(c * log2(c)) / n over the byte counts c
+    double sum = 0;
+    std::size_t distinct = 0;
+    for (const std::uint64_t c : histogram) {
+        if (c == 0) continue;
+        ++distinct;
+        if (c < xlogx.size()) {
+            sum += xlogx[c];
+        } else {
+            const auto value = static_cast<double>(c);
+            sum += value * std::log2(value);
+        }
+    }
+    if (distinct <= 1) return 0.0;
+    const auto n = static_cast<double>(total);
+    return std::max(0.0, std::log2(n) - sum / n);
+}
+
+EntropyAnalyzer::EntropyAnalyzer(const Options& options, const Formatter& formatter, const Color& color, OutputSink& sink)
+    : options_(options),
+      formatter_(formatter),
+      sink_(sink),
+      scale_{ color.sequence(Color::Code::BrightBlue), color.sequence(Color::Code::BrightCyan),
+              color.sequence(Color::Code::BrightGreen), color.sequence(Color::Code::BrightYellow),
+              color.sequence(Color::Code::BrightRed) },
+      reset_(color.sequence(Color::Code::Reset)),
+      line_size_(formatter.text_line_size(MAX_SUMMARY_SIZE)),
+      chunk_size_(std::max(options.entropy, ENTROPY_CHUNK_SIZE / options.entropy * options.entropy)) {
+    // Small blocks look up c * log2(c) instead of computing it 256 times per block
+    if (options_.entropy <= XLOGX_TABLE_LIMIT) {
+        xlogx_.resize(options_.entropy + 1);
+        for (std::size_t c = 1; c < xlogx_.size(); ++c) {
+            const auto value = static_cast<double>(c);
+            xlogx_[c] = value * std::log2(value);
+        }
+    }
+}
+
+char* EntropyAnalyzer::summarize_block(const unsigned char* data, std::size_t size, std::uint64_t offset, char* out) const {
+    ByteHistogram histogram{};
+    count_bytes(data, size, histogram);
+
+    const double entropy = histogram_entropy(histogram, size, xlogx_);
+    const std::uint64_t text = count_text(histogram);
+    const bool uniform = histogram[data[0]] == size;
+
+    char summary[MAX_SUMMARY_SIZE];
+    char* s = std::to_chars(summary, summary + 8, entropy, std::chars_format::fixed, 3).ptr;
+
+    // The bar is as long as the share of the 8 bits per byte, colored by range
+    const auto filled = static_cast<std::size_t>(std::lround(entropy / 8.0 * BAR_WIDTH));
+    const std::size_t level = entropy < 2.0 ? 0 : entropy < 4.0 ? 1 : entropy < 6.0 ? 2 : entropy < RANDOM_ENTROPY ? 3 : 4;
+    s = append(s, " |");
+    if (filled != 0) {
+        s = append(s, scale_[level]);
+        s = std::fill_n(s, filled, '#');
+        s = append(s, reset_);
+    }
+    s = std::fill_n(s, BAR_WIDTH - filled, '.');
+    s = append(s, "| text ");
+
+    const std::uint64_t percent = size == 0 ? 0 : (text * 100 + size / 2) / size;
+    char digits[4] = { ' ', ' ', ' ', '\0' };
+    std::to_chars(digits + (percent >= 100 ? 0 : percent >= 10 ? 1 : 2), digits + 3, percent);
+    s = append(s, std::string_view(digits, 3));
+    s = append(s, "%  ");
+
+    if (uniform) {
+        const std::size_t value = data[0];
+        if (value == 0) {
+            s = append(s, "zero");
+        } else {
+            const char* hex = options_.uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+            s = append(s, "fill ");
+            *s++ = hex[value >> 4];
+            *s++ = hex[value & 0xF];
+        }
+    } else if (percent >= TEXT_PERCENT) {
+        s = append(s, "text");
+    } else if (entropy >= RANDOM_ENTROPY) {
+        s = append(s, "random");
+    } else {
+        s = append(s, "data");
+    }
+
+    return formatter_.render_text_line(offset, std::string_view(summary, static_cast<std::size_t>(s - summary)), out);
+}
+
+char* EntropyAnalyzer::summarize(std::span<const std::byte> data, std::uint64_t offset, char* out) const {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+    for (std::size_t pos = 0; pos < data.size(); pos += options_.entropy) {
+        out = summarize_block(bytes + pos, std::min(options_.entropy, data.size() - pos), offset + pos, out);
+    }
+    return out;
+}
+
+int EntropyAnalyzer::run(int fd) {
+#if !defined(_WIN32) && !defined(_WIN64)
+    // Inputs with a known size are split into chunks up front
+    const std::uint64_t size = options_.threads > 1 && options_.filename != "-" ? seekable_size(fd) : 0;
+    if (size != 0) return run_parallel(fd, range_end(size, options_.start, options_.length));
+#endif
+    return run_streamed(fd);
+}
+
+void EntropyAnalyzer::summarize_chunk(int fd, ChunkSlot& slot) const {
+    if (slot.input.size() < slot.length) slot.input.resize(slot.length);
+    slot.length = read_at(fd, slot.input.data(), slot.length, slot.offset, slot.error);
+
+    const std::size_t blocks = (slot.length + options_.entropy - 1) / options_.entropy;
+    if (slot.output.size() < blocks * line_size_) slot.output.resize(blocks * line_size_);
+    char* out = summarize(std::span<const std::byte>(slot.input.data(), slot.length), slot.offset, slot.output.data());
+    slot.output_size = static_cast<std::size_t>(out - slot.output.data());
+}
+
+int EntropyAnalyzer::run_parallel(int fd, std::uint64_t end) {
+    OrderedChunks<ChunkSlot> chunks(options_.threads);
+    std::uint64_t next = options_.start;
+    int rc = 0;
+
+    chunks.run(
+        [&](ChunkSlot& slot) {
+            if (next >= end) return false;
+            slot.offset = next;
+            slot.length = static_cast<std::size_t>(std::min<std::uint64_t>(chunk_size_, end - next));
+            slot.error = 0;
+            next += slot.length;
+            return true;
+        },
+        [this, fd](ChunkSlot& slot) { summarize_chunk(fd, slot); },
+        [&](const ChunkSlot& slot) {
+            sink_.write(std::string_view(slot.output.data(), slot.output_size));
+            if (slot.error != 0) {
+                std::cerr << "Error: failed to read '" << options_.filename << "' at offset "
+                          << slot.offset + slot.length << ": " << std::strerror(slot.error) << "\n";
+                rc = 1;
+                return false;
+            }
+            return sink_.good();
+        });
+    return rc;
+}
+
+int EntropyAnalyzer::run_streamed(int fd) {
+    std::vector<std::byte> buffer(chunk_size_);
+    skip_to_start(fd, options_.start, options_.filename == "-", buffer);
+
+    std::uint64_t offset = options_.start;     // offset of buffer[0]
+    std::uint64_t remaining = options_.length; // 0 => unlimited
+    const bool limited = options_.length != 0;
+    int rc = 0;
+
+    for (bool eof = false; !eof;) {
+        std::size_t want = buffer.size();
+        if (limited && remaining < want) want = static_cast<std::size_t>(remaining);
+
+        // Chunks are whole blocks, so only the last block can be short
+        int error = 0;
+        const std::size_t got = read_full(fd, buffer.data(), want, error);
+        if (error != 0) {
+            std::cerr << "Error: failed to read input at offset " << offset + got << ": "
+                      << std::strerror(error) << "\n";
+            rc = 1;
+        }
+        eof = want == 0 || got < want;
+        if (limited) remaining -= got;
+
+        const auto* bytes = reinterpret_cast<const unsigned char*>(buffer.data());
+        for (std::size_t pos = 0; pos < got; pos += options_.entropy) {
+            char* out = sink_.reserve(line_size_);
+            sink_.commit(summarize_block(bytes + pos, std::min(options_.entropy, got - pos), offset + pos, out));
+        }
+        offset += got;
+    }
+    return rc;
+}
+
+} // namespace hexview
@@ -0,0 +1,260 @@
+#include "finder.hpp"
+#include "config.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace hexview {
+
+namespace {
+
+int hex_digit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+} // namespace
+
+SearchPattern SearchPattern::from_hex(std::string_view text) {
+    SearchPattern pattern;
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        if (std::isspace(static_cast<unsigned char>(text[pos]))) {
+            ++pos;
+            continue;
+        }
+        std::size_t end = pos;
+        while (end < text.size() && !std::isspace(static_cast<unsigned char>(text[end]))) ++end;
+        std::string_view token = text.substr(pos, end - pos);
+        pos = end;
+
+        if (token.size() > 2 && token[0] == '0' && (token[1] == 'x' || token[1] == 'X')) token.remove_prefix(2);
+        if (token.size() % 2 != 0) {
+            throw std::invalid_argument("hex pattern has an odd number of digits: " + std::string(token));
+        }
+        for (std::size_t i = 0; i < token.size(); i += 2) {
+            unsigned value = 0;
+            unsigned mask = 0;
+            for (std::size_t j = 0; j < 2; ++j) {
+                const unsigned shift = j == 0 ? 4 : 0;
+                if (token[i + j] == '?') continue;
+                const int digit = hex_digit(token[i + j]);
+                if (digit < 0) throw std::invalid_argument("invalid hex pattern: " + std::string(token));
+                value |= static_cast<unsigned>(digit) << shift;
+                mask |= 0xFu << shift;
+            }
+            pattern.value.push_back(static_cast<unsigned char>(value));
+            pattern.mask.push_back(static_cast<unsigned char>(mask));
+        }
+    }
+    return pattern;
+}
+
+SearchPattern SearchPattern::from_text(std::string_view text) {
+    SearchPattern pattern;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        unsigned char value = static_cast<unsigned char>(text[i]);
+        unsigned char mask = 0xFF;
+        if (text[i] == '?') {
+            value = 0;
+            mask = 0;
+        } else if (text[i] == '\\') {
+            if (++i == text.size()) throw std::invalid_argument("text pattern ends with a backslash");
+            switch (text[i]) {
+                case '\\': value = '\\'; break;
+                case '?': value = '?'; break;
+                case 'n': value = '\n'; break;
+                case 'r': value = '\r'; break;
+                case 't': value = '\t'; break;
+                case 'x': {
+                    const int high = i + 1 < text.size() ? hex_digit(text[i + 1]) : -1;
+                    const int low = i + 2 < text.size() ? hex_digit(text[i + 2]) : -1;
+                    if (high < 0 || low < 0) throw std::invalid_argument("\\x needs two hex digits in text pattern");
+                    value = static_cast<unsigned char>(high * 16 + low);
+                    i += 2;
+                    break;
+                }
+                default:
+                    throw std::invalid_argument(std::string("unknown escape in text pattern: \\") + text[i]);
+            }
+        }
+        pattern.value.push_back(value);
+        pattern.mask.push_back(mask);
+    }
+    return pattern;
+}
+
+Finder::Finder(const Options& options, const Formatter& formatter, OutputSink& sink)
+    : options_(options),
+      formatter_(formatter),
+      sink_(sink),
+      kernels_(hex_kernels()),
+      pattern_(options.find_text ? SearchPattern::from_text(options.find) : SearchPattern::from_hex(options.find)) {
+    const std::size_t size = pattern_.value.size();
+    if (size == 0) throw std::invalid_argument("empty search pattern");
+
+    // The pair filter needs two exact bytes; a single one is paired with itself
+    const auto exact = [this](std::size_t i) { return pattern_.mask[i] == 0xFF; };
+    first_ = size;
+    for (std::size_t i = 0; i < size; ++i) {
+        if (!exact(i)) continue;
+        if (first_ == size) first_ = i;
+        last_ = i;
+    }
+    if (first_ == size) throw std::invalid_argument("search pattern needs at least one byte without wildcards");
+
+    // Horspool shift: distance from the pattern's end to the last earlier
+    // position that can match the byte (wildcards match every byte)
+    shift_.fill(size);
+    for (std::size_t k = 0; k + 1 < size; ++k) {
+        if (exact(k)) {
+            shift_[pattern_.value[k]] = size - 1 - k;
+            continue;
+        }
+        for (unsigned c = 0; c < 256; ++c) {
+            if ((c & pattern_.mask[k]) == pattern_.value[k]) shift_[c] = size - 1 - k;
+        }
+    }
+}
+
+std::uint64_t Finder::line_of(std::uint64_t offset) const {
+    const std::size_t BPL = options_.bytes_per_line;
+    return offset - (offset - options_.start) % BPL;
+}
+
+bool Finder::matches_at(const unsigned char* p) const {
+    for (std::size_t j = pattern_.value.size(); j-- > 0;) {
+        if ((p[j] & pattern_.mask[j]) != pattern_.value[j]) return false;
+    }
+    return true;
+}
+
+void Finder::add_match(std::uint64_t begin) {
+    const std::size_t BPL = options_.bytes_per_line;
+    const std::uint64_t context = static_cast<std::uint64_t>(options_.context) * BPL;
+    const std::uint64_t end = begin + pattern_.value.size();
+
+    std::uint64_t from = line_of(begin);
+    from = from - options_.start > context ? from - context : options_.start;
+    const std::uint64_t to = line_of(end - 1) + BPL + context;
+
+    if (from > print_end_) {
+        // The previous group is complete: every match that can touch it is known
+        print_until(print_end_, std::numeric_limits<std::uint64_t>::max());
+        if (printed_any_ && options_.context != 0) sink_.write("--\n");
+        printed_ = from;
+    }
+    print_end_ = std::max(print_end_, to);
+    matches_.push_back({ begin, end });
+
+    // Later matches start at or after this one, so the lines in front of it are final
+    print_until(line_of(begin), std::numeric_limits<std::uint64_t>::max());
+}
+
+void Finder::print_until(std::uint64_t until, std::uint64_t end) {
+    const std::size_t BPL = options_.bytes_per_line;
+    until = std::min({ until, print_end_, end });
+    while (printed_ < until) {
+        const auto size = static_cast<std::size_t>(std::min<std::uint64_t>(BPL, end - printed_));
+        const std::uint64_t line_end = printed_ + size;
+
+        // Highlight the parts of the matches that fall on this line
+        while (!matches_.empty() && matches_.front().end <= printed_) matches_.pop_front();
+        marks_.assign(size, 0);
+        for (const Match& match : matches_) {
+            if (match.begin >= line_end) break;
+            const auto from = static_cast<std::size_t>(std::max(match.begin, printed_) - printed_);
+            const auto to = static_cast<std::size_t>(std::min(match.end, line_end) - printed_);
+            std::fill(marks_.begin() + static_cast<std::ptrdiff_t>(from), marks_.begin() + static_cast<std::ptrdiff_t>(to), 1);
+        }
+
+        const std::span<const std::byte> line(buffer_.data() + (printed_ - buffer_offset_), size);
+        char* out = sink_.reserve(formatter_.max_line_size());
+        sink_.commit(formatter_.render_marked_line(line, marks_, printed_, out));
+        printed_any_ = true;
+        printed_ = line_end;
+    }
+}
+
+int Finder::run(int fd) {
+    const std::size_t size = pattern_.value.size();
+    const std::uint64_t context = static_cast<std::uint64_t>(options_.context) * options_.bytes_per_line;
+    buffer_.resize(FIND_BLOCK_SIZE);
+
+    skip_to_start(fd, options_.start, options_.filename == "-", buffer_);
+
+    buffer_offset_ = options_.start;
+    printed_ = print_end_ = options_.start;
+    std::size_t filled = 0;
+    std::uint64_t searched = options_.start;   // every start before this has been checked
+    std::uint64_t remaining = options_.length; // 0 => unlimited
+    const bool limited = options_.length != 0;
+    int rc = 0;
+
+    for (;;) {
+        // Carry what the next block still needs: unchecked starts, the
+        // unprinted lines of the current group and the context of a future match
+        std::uint64_t keep = line_of(searched);
+        keep = keep - options_.start > context ? keep - context : options_.start;
+        if (printed_ < print_end_) keep = std::min(keep, printed_);
+        keep = std::max(keep, buffer_offset_);
+        const auto drop = static_cast<std::size_t>(keep - buffer_offset_);
+        if (drop != 0) {
+            filled -= drop;
+            std::memmove(buffer_.data(), buffer_.data() + drop, filled);
+            buffer_offset_ = keep;
+        }
+        if (buffer_.size() < filled + FIND_BLOCK_SIZE) buffer_.resize(filled + FIND_BLOCK_SIZE);
+
+        std::size_t want = FIND_BLOCK_SIZE;
+        if (limited && remaining < want) want = static_cast<std::size_t>(remaining);
+        long got = want == 0 ? 0 : read_some(fd, buffer_.data() + filled, want);
+        if (got < 0) {
+            std::cerr << "Error: failed to read input at offset " << buffer_offset_ + filled << ": "
+                      << std::strerror(errno) << "\n";
+            rc = 2;
+        }
+        const bool eof = got <= 0;
+        if (!eof) {
+            filled += static_cast<std::size_t>(got);
+            if (limited) remaining -= static_cast<std::uint64_t>(got);
+        }
+        const std::uint64_t buffer_end = buffer_offset_ + filled;
+
+        // Jump between pair filter candidates, verify each and shift past it
+        const auto* base = reinterpret_cast<const unsigned char*>(buffer_.data());
+        while (searched + size <= buffer_end) {
+            const auto at = static_cast<std::size_t>(searched - buffer_offset_);
+            const auto count = static_cast<std::size_t>(buffer_end - size + 1 - searched);
+            const std::size_t hit = kernels_.find_pair(base + at + first_, count, pattern_.value[first_],
+                                                       pattern_.value[last_], last_ - first_);
+            if (hit == count) {
+                searched += count;
+                break;
+            }
+            const std::size_t candidate = at + hit;
+            if (matches_at(base + candidate)) add_match(buffer_offset_ + candidate);
+            searched = buffer_offset_ + candidate + shift_[base[candidate + size - 1]];
+        }
+
+        if (eof) {
+            print_until(print_end_, buffer_end);
+            break;
+        }
+        // Lines ending before the next unchecked start cannot gain a match
+        print_until(line_of(searched), buffer_end);
+    }
+
+    if (rc != 0) return rc;
+    return printed_any_ ? 0 : 1;
+}
+
+} // namespace hexview
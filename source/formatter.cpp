@@ -1,141 +1,494 @@
 #include "formatter.hpp"
 #include "utils.hpp"
-#include <iostream>
-#include <sstream>
 #include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <utility>
 
 namespace hexview {
 
-Formatter::Formatter(const Options& options, const Color& color)
-    : options_(options), color_(color) {}
+namespace {
 
-void Formatter::format_line(const std::vector<unsigned char>& bytes, std::uint64_t line_offset) const {
+// Bytes of a line swapped and encoded per pass of the word renderer
+constexpr std::size_t WORD_CHUNK = 256;
+
+/**
+ * @brief Width of a value column cell: the longest unsigned decimal or shortest round-trip float
+ */
+std::size_t value_cell_width(Options::WordValues values, std::size_t word) {
+    if (values == Options::WordValues::Dec) return word == 2 ? 5 : (word == 4 ? 10 : 20);
+    if (values == Options::WordValues::Float) return word == 4 ? 15 : 24;   // "-1.00000005e-38", "-2.2250738585072014e-308"
+    return 0;
+}
+
+template <std::size_t WORD>
+std::uint64_t word_value(const unsigned char* bytes, bool big_endian) {
+    std::uint64_t value = 0;
+    for (std::size_t j = 0; j < WORD; ++j) {
+        const std::size_t shift = 8 * (big_endian ? WORD - 1 - j : j);
+        value |= std::uint64_t{bytes[j]} << shift;
+    }
+    return value;
+}
+
+} // namespace
+
+Formatter::Formatter(const Options& options, const Color& color, OutputSink& sink)
+    : options_(options),
+      color_(color),
+      sink_(sink),
+      group_(std::max<std::size_t>(1, options.group)),
+      hex_pairs_(hex_pairs(options.uppercase)),
+      kernels_(hex_kernels()),
+      spread_(make_hex_spread(group_)),
+      cells_(make_cell_table(options.encoding, options.uppercase)),
+      cell_width_(cell_width(options.encoding)),
+      word_(options.word),
+      swap_words_(options.endian == Options::Endian::Little),
+      value_width_(value_cell_width(options.word_values, options.word)),
+      ascii_cells_(make_ascii_cell_table(options.show_escapes, options.show_non_printable_as_dot)),
+      printable_color_(color_.sequence(Color::Code::BrightGreen)),
+      non_printable_color_(color_.sequence(Color::Code::BrightYellow)),
+      mark_color_(color_.sequence(Color::Code::BrightRed)),
+      reset_color_(color_.sequence(Color::Code::Reset)),
+      substitute_(options.show_non_printable_as_dot ? '.' : '?') {
+    const std::size_t BPL = options_.bytes_per_line;
+    const std::size_t color_size = std::max({ printable_color_.size(), non_printable_color_.size(), mark_color_.size() })
+                                 + reset_color_.size();
+
+    // offset (widest of the requested width and a full 64-bit decimal) + ": "
+    std::size_t size = std::max<std::size_t>(options_.offset_width, 20) + 2;
+    // byte cells plus at most two separator characters between cells
+    size += BPL * (cell_width_ + color_size) + BPL * 2;
+    // value column of word dumps
+    if (value_width_ != 0) size += 1 + (BPL / word_) * (value_width_ + 1);
+    // column separator, ASCII cells ("\xHH" is the widest) and newline
+    size += 1 + BPL * (4 + color_size) + 1;
+    // vector kernels store whole registers past the characters they keep
+    size += SIMD_STORE_SLACK;
+
+    // markers carry a label and two offsets
+    const std::size_t marker_size = std::strlen("*  -\n") + MAX_MARKER_LABEL + 2 * std::max<std::size_t>(options_.offset_width, 20);
+    max_line_size_ = std::max(size, marker_size);
+
+    // Escapes and unequal color sequences make line sizes depend on content
+    const bool show_hex = !options_.ascii_only;
+    const bool show_ascii = !options_.hex_only;
+    line_body_size_ = 0;
+    if (printable_color_.size() == non_printable_color_.size() && !(show_ascii && options_.show_escapes)) {
+        const std::size_t cell_color = printable_color_.size() + reset_color_.size();
+        std::size_t body = 1; // newline
+        if (show_hex && word_ > 1) {
+            // word cells are not colored
+            const std::size_t words = BPL / word_;
+            body += words * 2 * word_ + (words - 1) + (words - 1) / group_;
+            if (value_width_ != 0) body += 1 + words * value_width_ + (words - 1);
+        } else if (show_hex) {
+            body += BPL * (cell_width_ + cell_color) + (BPL - 1) + (BPL - 1) / group_;
+        }
+        if (show_ascii) body += BPL * (1 + cell_color);
+        if (show_hex && show_ascii) body += 1;
+        line_body_size_ = body;
+    }
+}
+
+void Formatter::format_line(std::span<const std::byte> bytes, std::uint64_t line_offset) const {
+    char* out = sink_.reserve(max_line_size_);
+    sink_.commit(render_line(bytes, line_offset, out));
+}
+
+bool Formatter::use_fixed_layout() {
+    struct Preset {
+        std::size_t bytes_per_line;
+        std::size_t group;
+        // indexed by [column layout][offset shown][vector hex column]
+        FullLineRenderer renderers[4][2][2];
+    };
+
+    auto preset = []<std::size_t BPL, std::size_t GROUP>() {
+        Preset p{ BPL, GROUP, {} };
+        auto fill = [&]<ColumnLayout COLUMNS>() {
+            auto& slot = p.renderers[static_cast<std::size_t>(COLUMNS)];
+            slot[0][0] = &Formatter::render_fixed_line<BPL, GROUP, COLUMNS, false, false>;
+            slot[0][1] = &Formatter::render_fixed_line<BPL, GROUP, COLUMNS, false, true>;
+            slot[1][0] = &Formatter::render_fixed_line<BPL, GROUP, COLUMNS, true, false>;
+            slot[1][1] = &Formatter::render_fixed_line<BPL, GROUP, COLUMNS, true, true>;
+        };
+        fill.template operator()<ColumnLayout::HexAscii>();
+        fill.template operator()<ColumnLayout::AsciiHex>();
+        fill.template operator()<ColumnLayout::HexOnly>();
+        fill.template operator()<ColumnLayout::AsciiOnly>();
+        return p;
+    };
+
+    static const Preset presets[] = {
+        preset.template operator()<16, 1>(),
+        preset.template operator()<16, 2>(),
+        preset.template operator()<16, 4>(),
+        preset.template operator()<32, 4>(),
+        preset.template operator()<32, 8>(),
+    };
+
+    full_line_ = nullptr;
+    // The fixed renderers emit hex pairs, exactly one character per ASCII cell and no color
+    if (!reset_color_.empty() || options_.show_escapes || options_.encoding != Options::Encoding::Hex || word_ > 1) {
+        return false;
+    }
+
+    const bool vector = kernels_.level >= SimdLevel::SSSE3;
+    for (const Preset& p : presets) {
+        if (p.bytes_per_line == options_.bytes_per_line && p.group == group_) {
+            full_line_ = p.renderers[static_cast<std::size_t>(column_layout(options_))]
+                                    [options_.hide_offset ? 0 : 1][vector ? 1 : 0];
+            return true;
+        }
+    }
+    return false;
+}
+
+template <std::size_t BPL, std::size_t GROUP, ColumnLayout COLUMNS, bool OFFSET, bool VECTOR>
+char* Formatter::render_fixed_line(const unsigned char* bytes, std::uint64_t line_offset, char* out) const {
+    using Layout = LineLayout<BPL, GROUP>;
+
+    auto hex_column = [&](char* dst) {
+        if constexpr (VECTOR && Layout::VECTOR_SPREAD) {
+            // separators the kernel writes after the last byte are overwritten by what follows
+            kernels_.encode_hex_spread(bytes, BPL / 16, dst, options_.uppercase, spread_);
+        } else {
+            std::memset(dst, ' ', Layout::HEX_WIDTH);
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                (std::memcpy(dst + Layout::CELL_POSITIONS[I], hex_pairs_ + 2 * bytes[I], 2), ...);
+            }(std::make_index_sequence<BPL>{});
+        }
+        return dst + Layout::HEX_WIDTH;
+    };
+    auto ascii_column = [&](char* dst) {
+        kernels_.map_ascii(bytes, BPL, dst, substitute_);
+        return dst + BPL;
+    };
+
+    if constexpr (OFFSET) out = render_offset(line_offset, out);
+    if constexpr (COLUMNS == ColumnLayout::HexAscii) {
+        out = hex_column(out);
+        *out++ = ' ';
+        out = ascii_column(out);
+    } else if constexpr (COLUMNS == ColumnLayout::AsciiHex) {
+        out = ascii_column(out);
+        *out++ = ' ';
+        out = hex_column(out);
+    } else if constexpr (COLUMNS == ColumnLayout::HexOnly) {
+        out = hex_column(out);
+    } else {
+        out = ascii_column(out);
+    }
+    *out++ = '\n';
+    return out;
+}
+
+char* Formatter::render_line(std::span<const std::byte> line, std::uint64_t line_offset, char* out) const {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(line.data());
+    const std::size_t count = line.size();
+
+    if (full_line_ != nullptr && count == options_.bytes_per_line) {
+        return (this->*full_line_)(bytes, line_offset, out);
+    }
+    return render_generic_line(bytes, count, nullptr, line_offset, out);
+}
+
+char* Formatter::render_marked_line(std::span<const std::byte> line, std::span<const std::uint8_t> marks,
+                                    std::uint64_t line_offset, char* out) const {
+    // Without color there is nothing to highlight
+    if (mark_color_.empty()) return render_line(line, line_offset, out);
+    return render_generic_line(reinterpret_cast<const unsigned char*>(line.data()), line.size(),
+                               marks.data(), line_offset, out);
+}
+
+char* Formatter::render_generic_line(const unsigned char* bytes, std::size_t count, const std::uint8_t* marks,
+                                     std::uint64_t line_offset, char* out) const {
+    out = render_offset(line_offset, out);
     if (!options_.ascii_only && !options_.hex_only) {
         // Both columns enabled
-        print_offset(line_offset);
         if (options_.swap_columns) {
             // ASCII first
-            print_ascii_column_colored(bytes);
-            std::cout << " ";
-            print_hex_column_colored(bytes);
+            out = render_ascii_column(bytes, count, marks, out);
+            *out++ = ' ';
+            out = render_hex_column(bytes, count, marks, out);
         } else {
             // Hex first
-            print_hex_column_colored(bytes);
-            std::cout << " ";
-            print_ascii_column_colored(bytes);
+            out = render_hex_column(bytes, count, marks, out);
+            *out++ = ' ';
+            out = render_ascii_column(bytes, count, marks, out);
         }
-        std::cout << '\n';
     } else if (options_.hex_only) {
         // hex only: omit ASCII
-        print_offset(line_offset);
-        print_hex_column_colored(bytes);
-        std::cout << '\n';
+        out = render_hex_column(bytes, count, marks, out);
     } else { // ascii_only
-        print_offset(line_offset);
-        print_ascii_column_colored(bytes);
-        std::cout << '\n';
+        out = render_ascii_column(bytes, count, marks, out);
     }
+    *out++ = '\n';
+    return out;
 }
 
-std::string Formatter::make_hex_column(const std::vector<unsigned char>& bytes) const {
-    std::ostringstream oss;
-    const std::size_t BPL = options_.bytes_per_line;
-    const std::size_t group = std::max<std::size_t>(1, options_.group);
+std::string_view Formatter::cell_color(std::size_t i, std::uint64_t printable, const std::uint8_t* marks) const {
+    if (marks != nullptr && marks[i] != 0) return mark_color_;
+    return ((printable >> (i % 64)) & 1) ? printable_color_ : non_printable_color_;
+}
 
-    for (std::size_t i = 0; i < BPL; ++i) {
-        if (i < bytes.size()) {
-            unsigned int b = static_cast<unsigned int>(bytes[i]);
-            oss << to_hex_byte(b, options_.uppercase);
-        } else {
-            oss << "  ";
-        }
-        if (i != BPL - 1) {
-            if ((i % group) == (group - 1)) oss << "  ";
-            else oss << " ";
-        }
-    }
-    return oss.str();
+char* Formatter::render_marker(std::string_view label, std::uint64_t begin, std::uint64_t end, char* out) const {
+    *out++ = '*';
+    *out++ = ' ';
+    out = append(out, label.substr(0, MAX_MARKER_LABEL));
+    *out++ = ' ';
+    out = render_offset_digits(begin, out);
+    *out++ = '-';
+    out = render_offset_digits(end, out);
+    *out++ = '\n';
+    return out;
 }
 
-std::string Formatter::make_ascii_column(const std::vector<unsigned char>& bytes) const {
-    std::ostringstream oss;
-    const std::size_t BPL = options_.bytes_per_line;
+char* Formatter::render_hole(std::uint64_t begin, std::uint64_t end, char* out) const {
+    return render_marker("hole", begin, end, out);
+}
 
-    for (std::size_t i = 0; i < bytes.size(); ++i) {
-        unsigned char ch = bytes[i];
-        std::string rep = escape_byte(ch, options_.show_escapes, options_.show_non_printable_as_dot);
-        oss << rep;
-    }
+char* Formatter::render_text_line(std::uint64_t offset, std::string_view text, char* out) const {
+    out = render_offset(offset, out);
+    out = append(out, text);
+    *out++ = '\n';
+    return out;
+}
 
-    // Pad with spaces equal to missing bytes to keep the column aligned
-    if (bytes.size() < BPL) {
-        std::size_t pad = BPL - bytes.size();
-        for (std::size_t p = 0; p < pad; ++p) oss << ' ';
-    }
-    return oss.str();
+std::size_t Formatter::text_line_size(std::size_t text_size) const {
+    return std::max<std::size_t>(options_.offset_width, 20) + 2 + text_size + 1;
 }
 
-void Formatter::print_offset(std::uint64_t line_offset) const {
-    if (options_.hide_offset) return;
+char* Formatter::render_offset(std::uint64_t line_offset, char* out) const {
+    if (options_.hide_offset) return out;
+
+    out = render_offset_digits(line_offset, out);
+    *out++ = ':';
+    *out++ = ' ';
+    return out;
+}
 
+char* Formatter::render_offset_digits(std::uint64_t line_offset, char* out) const {
     if (options_.offset_format == Options::OffsetFormat::Hex) {
-        std::string off = to_hex_uint(line_offset, options_.offset_width, options_.uppercase);
-        std::cout << off << ": ";
+        // zero padded to offset_width, growing when the value needs more digits
+        std::size_t digits = 1;
+        for (std::uint64_t v = line_offset >> 4; v != 0; v >>= 4) ++digits;
+        std::size_t width = std::max(options_.offset_width, digits);
+
+        std::memset(out, '0', width - digits);
+        char* p = out + width;
+        std::uint64_t v = line_offset;
+        for (std::size_t i = 0; i < digits; ++i) {
+            *--p = hex_pairs_[2 * (v & 0x0F) + 1];
+            v >>= 4;
+        }
+        out += width;
     } else {
         // decimal format (no leading zeros)
-        std::cout << std::dec << line_offset << ": ";
-        // restore formatting for other uses
-        std::cout << std::hex << std::nouppercase;
+        out = std::to_chars(out, out + 20, line_offset).ptr;
+    }
+    return out;
+}
+
+std::size_t Formatter::offset_size(std::uint64_t line_offset) const {
+    if (options_.hide_offset) return 0;
+
+    std::size_t digits = 1;
+    if (options_.offset_format == Options::OffsetFormat::Hex) {
+        for (std::uint64_t v = line_offset >> 4; v != 0; v >>= 4) ++digits;
+        digits = std::max(options_.offset_width, digits);
+    } else {
+        for (std::uint64_t v = line_offset / 10; v != 0; v /= 10) ++digits;
+    }
+    return digits + 2;
+}
+
+std::uint64_t Formatter::full_lines_size(std::uint64_t first_offset, std::uint64_t lines) const {
+    std::uint64_t total = lines * line_body_size_;
+    if (options_.hide_offset) return total;
+
+    // The offset width only changes when the offset gains a digit, so lines
+    // are counted in runs between consecutive powers of the radix
+    const std::uint64_t BPL = options_.bytes_per_line;
+    const std::uint64_t radix = (options_.offset_format == Options::OffsetFormat::Hex) ? 16 : 10;
+    std::uint64_t line = 0;
+    while (line < lines) {
+        const std::uint64_t offset = first_offset + line * BPL;
+        std::uint64_t limit = 1;
+        while (limit <= offset && limit <= UINT64_MAX / radix) limit *= radix;
+
+        std::uint64_t run = lines - line;
+        if (limit > offset) run = std::min(run, (limit - offset + BPL - 1) / BPL);
+        total += run * offset_size(offset);
+        line += run;
     }
+    return total;
 }
 
-void Formatter::print_hex_column_colored(const std::vector<unsigned char>& bytes) const {
+char* Formatter::render_hex_column(const unsigned char* bytes, std::size_t count, const std::uint8_t* marks, char* out) const {
     const std::size_t BPL = options_.bytes_per_line;
-    const std::size_t group = std::max<std::size_t>(1, options_.group);
-
-    for (std::size_t i = 0; i < BPL; ++i) {
-        if (i < bytes.size()) {
-            unsigned int b = static_cast<unsigned int>(bytes[i]);
-            bool printable = is_printable_ascii(static_cast<unsigned char>(b));
-            if (!printable) color_.set(Color::Code::BrightYellow);
-            else color_.set(Color::Code::BrightGreen);
-            std::cout << to_hex_byte(b, options_.uppercase);
-            color_.reset();
+    const bool colored = !reset_color_.empty();
+    std::size_t i = 0;
+
+    if (word_ > 1) return render_word_column(bytes, count, out);
+
+    if (!colored && cell_width_ == 2 && spread_.group != 0 && count >= 16) {
+        // Whole 16-byte blocks go through the vector kernel, separators included
+        const std::size_t blocks = count / 16;
+        out = kernels_.encode_hex_spread(bytes, blocks, out, options_.uppercase, spread_);
+        i = blocks * 16;
+        if (i == BPL) {
+            // the layout has no separator after the last byte of the line
+            return out - ((BPL % group_ == 0) ? 2 : 1);
+        }
+    }
+
+    std::uint64_t printable = 0;
+    for (std::size_t in_group = (i % group_) + 1; i < BPL; ++i, ++in_group) {
+        if (i < count) {
+            const unsigned char b = bytes[i];
+            if (colored) {
+                if (i % 64 == 0) {
+                    printable = kernels_.classify_printable(bytes + i, std::min<std::size_t>(64, count - i));
+                }
+                out = append(out, cell_color(i, printable, marks));
+            }
+            // whole padded cell in one store; what follows overwrites the padding
+            std::memcpy(out, cells_.data() + 8 * b, 8);
+            out += cell_width_;
+            if (colored) out = append(out, reset_color_);
         } else {
-            std::cout << "  ";
+            std::memset(out, ' ', cell_width_);
+            out += cell_width_;
         }
         if (i != BPL - 1) {
-            if ((i % group) == (group - 1)) std::cout << "  ";
-            else std::cout << " ";
+            *out++ = ' ';
+            if (in_group == group_) {
+                *out++ = ' ';
+                in_group = 0;
+            }
         }
     }
+    return out;
+}
+
+char* Formatter::render_word_column(const unsigned char* bytes, std::size_t count, char* out) const {
+    switch (word_) {
+        case 2: return render_words<2>(bytes, count, out);
+        case 4: return render_words<4>(bytes, count, out);
+        default: return render_words<8>(bytes, count, out);
+    }
 }
 
-void Formatter::print_ascii_column_colored(const std::vector<unsigned char>& bytes) const {
+template <std::size_t WORD>
+char* Formatter::render_words(const unsigned char* bytes, std::size_t count, char* out) const {
+    const std::size_t words = options_.bytes_per_line / WORD;
+    const std::size_t whole = count / WORD;
+    std::size_t w = 0;
+
+    auto separator = [&] {
+        if (w + 1 == words) return;
+        *out++ = ' ';
+        if ((w + 1) % group_ == 0) *out++ = ' ';
+    };
+
+    // Whole words: swap the byte order of a chunk in one kernel call, encode it, then place the digits
+    alignas(64) unsigned char swapped[WORD_CHUNK];
+    char digits[2 * WORD_CHUNK];
+    for (std::size_t pos = 0; pos < whole * WORD; pos += WORD_CHUNK) {
+        const std::size_t n = std::min(WORD_CHUNK, whole * WORD - pos);
+        const unsigned char* src = bytes + pos;
+        if (swap_words_) {
+            kernels_.swap_bytes(src, n, swapped, WORD);
+            src = swapped;
+        }
+        kernels_.encode_hex(src, n, digits, options_.uppercase);
+        for (std::size_t k = 0; k < n / WORD; ++k, ++w) {
+            std::memcpy(out, digits + 2 * WORD * k, 2 * WORD);
+            out += 2 * WORD;
+            separator();
+        }
+    }
+
+    // A short last word keeps each present byte's digits where they would be in a whole word
+    if (const std::size_t present = count - whole * WORD; present != 0) {
+        std::memset(out, ' ', 2 * WORD);
+        for (std::size_t j = 0; j < present; ++j) {
+            const std::size_t pair = swap_words_ ? WORD - 1 - j : j;
+            std::memcpy(out + 2 * pair, hex_pairs_ + 2 * bytes[whole * WORD + j], 2);
+        }
+        out += 2 * WORD;
+        separator();
+        ++w;
+    }
+    for (; w < words; ++w) {
+        std::memset(out, ' ', 2 * WORD);
+        out += 2 * WORD;
+        separator();
+    }
+
+    if (value_width_ == 0) return out;
+
+    // Value column: right-aligned, blank for a short last word and missing words
+    const bool big_endian = !swap_words_;
+    *out++ = ' ';
+    for (w = 0; w < words; ++w) {
+        char text[32];
+        char* end = text;
+        if (w < whole) {
+            const std::uint64_t value = word_value<WORD>(bytes + w * WORD, big_endian);
+            if (options_.word_values == Options::WordValues::Dec) {
+                end = std::to_chars(text, text + sizeof(text), value).ptr;
+            } else if constexpr (WORD == 4) {
+                end = std::to_chars(text, text + sizeof(text),
+                                    std::bit_cast<float>(static_cast<std::uint32_t>(value))).ptr;
+            } else if constexpr (WORD == 8) {
+                end = std::to_chars(text, text + sizeof(text), std::bit_cast<double>(value)).ptr;
+            }
+        }
+        const auto size = static_cast<std::size_t>(end - text);
+        std::memset(out, ' ', value_width_ - size);
+        std::memcpy(out + value_width_ - size, text, size);
+        out += value_width_;
+        if (w + 1 != words) *out++ = ' ';
+    }
+    return out;
+}
+
+char* Formatter::render_ascii_column(const unsigned char* bytes, std::size_t count, const std::uint8_t* marks, char* out) const {
     const std::size_t BPL = options_.bytes_per_line;
+    const bool colored = !reset_color_.empty();
 
-    for (std::size_t i = 0; i < bytes.size(); ++i) {
-        unsigned char ch = bytes[i];
-        if (is_printable_ascii(ch)) {
-            color_.set(Color::Code::BrightGreen);
-            std::cout << static_cast<char>(ch);
-        } else {
-            color_.set(Color::Code::BrightYellow);
-            if (options_.show_escapes) {
-                std::string rep = escape_byte(ch, true, false);
-                std::cout << rep;
-            } else {
-                std::cout << (options_.show_non_printable_as_dot ? '.' : '?');
+    if (!colored && !options_.show_escapes) {
+        // One character per byte: a vector blend of the byte and its substitute
+        kernels_.map_ascii(bytes, count, out, substitute_);
+        out += count;
+    } else {
+        std::uint64_t printable = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const AsciiCell& cell = ascii_cells_[bytes[i]];
+            if (colored) {
+                if (i % 64 == 0) {
+                    printable = kernels_.classify_printable(bytes + i, std::min<std::size_t>(64, count - i));
+                }
+                out = append(out, cell_color(i, printable, marks));
             }
+            std::memcpy(out, cell.text, sizeof(cell.text));
+            out += cell.size;
+            if (colored) out = append(out, reset_color_);
         }
-        color_.reset();
     }
 
     // pad missing bytes visually (count bytes, not characters)
-    if (bytes.size() < BPL) {
-        std::size_t pad = BPL - bytes.size();
-        for (std::size_t p = 0; p < pad; ++p) std::cout << ' ';
+    if (count < BPL) {
+        std::size_t pad = BPL - count;
+        std::memset(out, ' ', pad);
+        out += pad;
     }
+    return out;
 }
 
-} // namespace hexview
\ No newline at end of file
+} // namespace hexview
@@ -0,0 +1,177 @@
+#include "io_ring.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(HEXVIEW_HAVE_IO_URING)
+#  include <cerrno>
+#  include <linux/io_uring.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <sys/uio.h>
+#  include <unistd.h>
+#  include <vector>
+#endif
+
+namespace hexview {
+
+#if defined(HEXVIEW_HAVE_IO_URING)
+
+namespace {
+
+template <typename T>
+T* ring_field(void* ring, std::uint32_t offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+} // namespace
+
+IoRing::~IoRing() {
+    if (sqes_ != nullptr) ::munmap(sqes_, sqes_size_);
+    if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) ::munmap(cq_ring_, cq_ring_size_);
+    if (sq_ring_ != nullptr) ::munmap(sq_ring_, sq_ring_size_);
+    if (fd_ >= 0) ::close(fd_);
+}
+
+bool IoRing::setup(unsigned entries) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    long fd = ::syscall(__NR_io_uring_setup, entries, &params);
+    if (fd < 0) return false;
+    fd_ = static_cast<int>(fd);
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+
+    void* sq = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      fd_, IORING_OFF_SQ_RING);
+    if (sq == MAP_FAILED) return false;
+    sq_ring_ = sq;
+
+    if (single_mmap) {
+        cq_ring_ = sq_ring_;
+    } else {
+        void* cq = ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          fd_, IORING_OFF_CQ_RING);
+        if (cq == MAP_FAILED) return false;
+        cq_ring_ = cq;
+    }
+
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) return false;
+    sqes_ = sqes;
+
+    sq_head_ = ring_field<unsigned>(sq_ring_, params.sq_off.head);
+    sq_tail_ = ring_field<unsigned>(sq_ring_, params.sq_off.tail);
+    sq_array_ = ring_field<unsigned>(sq_ring_, params.sq_off.array);
+    sq_mask_ = *ring_field<unsigned>(sq_ring_, params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+    cq_head_ = ring_field<unsigned>(cq_ring_, params.cq_off.head);
+    cq_tail_ = ring_field<unsigned>(cq_ring_, params.cq_off.tail);
+    cq_mask_ = *ring_field<unsigned>(cq_ring_, params.cq_off.ring_mask);
+    cqes_ = ring_field<void>(cq_ring_, params.cq_off.cqes);
+    return true;
+}
+
+bool IoRing::register_buffers(std::byte* base, std::size_t size, unsigned count) {
+    std::vector<iovec> iovecs(count);
+    for (unsigned i = 0; i < count; ++i) {
+        iovecs[i].iov_base = base + std::size_t{i} * size;
+        iovecs[i].iov_len = size;
+    }
+    fixed_buffers_ = ::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS,
+                               iovecs.data(), count) == 0;
+    return fixed_buffers_;
+}
+
+bool IoRing::queue_read(int fd, std::byte* data, std::size_t size, std::uint64_t offset,
+                        unsigned buffer_index, std::uint64_t user_data) {
+    const unsigned tail = *sq_tail_;
+    if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) return false;
+
+    const unsigned index = tail & sq_mask_;
+    io_uring_sqe* sqe = static_cast<io_uring_sqe*>(sqes_) + index;
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = fixed_buffers_ ? IORING_OP_READ_FIXED : IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->off = offset;
+    sqe->addr = reinterpret_cast<std::uint64_t>(data);
+    sqe->len = static_cast<std::uint32_t>(size);
+    if (fixed_buffers_) sqe->buf_index = static_cast<std::uint16_t>(buffer_index);
+    sqe->user_data = user_data;
+
+    sq_array_[index] = index;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    ++unsubmitted_;
+    return true;
+}
+
+bool IoRing::submit(unsigned wait_for) {
+    for (;;) {
+        const unsigned flags = wait_for != 0 ? IORING_ENTER_GETEVENTS : 0u;
+        long n = ::syscall(__NR_io_uring_enter, fd_, unsubmitted_, wait_for, flags, nullptr, 0);
+        if (n >= 0) {
+            unsubmitted_ -= static_cast<unsigned>(n);
+            return true;
+        }
+        if (errno != EINTR && errno != EAGAIN) return false;
+    }
+}
+
+bool IoRing::reap(std::uint64_t& user_data, std::int32_t& result) {
+    const unsigned head = *cq_head_;
+    if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) return false;
+
+    const io_uring_cqe* cqe = static_cast<const io_uring_cqe*>(cqes_) + (head & cq_mask_);
+    user_data = cqe->user_data;
+    result = cqe->res;
+    __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+#else
+
+IoRing::~IoRing() = default;
+
+bool IoRing::setup(unsigned entries) {
+    (void)entries;
+    return false;
+}
+
+bool IoRing::register_buffers(std::byte* base, std::size_t size, unsigned count) {
+    (void)base;
+    (void)size;
+    (void)count;
+    return false;
+}
+
+bool IoRing::queue_read(int fd, std::byte* data, std::size_t size, std::uint64_t offset,
+                        unsigned buffer_index, std::uint64_t user_data) {
+    (void)fd;
+    (void)data;
+    (void)size;
+    (void)offset;
+    (void)buffer_index;
+    (void)user_data;
+    return false;
+}
+
+bool IoRing::submit(unsigned wait_for) {
+    (void)wait_for;
+    return false;
+}
+
+bool IoRing::reap(std::uint64_t& user_data, std::int32_t& result) {
+    (void)user_data;
+    (void)result;
+    return false;
+}
+
+#endif
+
+} // namespace hexview
@@ -0,0 +1,74 @@
+#include "line_squeezer.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace hexview {
+
+LineSqueezer::LineSqueezer(const Formatter& formatter, std::size_t bytes_per_line)
+    : formatter_(formatter),
+      kernels_(hex_kernels()),
+      bytes_per_line_(bytes_per_line),
+      previous_(bytes_per_line) {}
+
+bool LineSqueezer::repeats(std::span<const std::byte> line) const {
+    if (!have_previous_ || line.size() != bytes_per_line_) return false;
+    return kernels_.mismatch(reinterpret_cast<const unsigned char*>(line.data()),
+                             reinterpret_cast<const unsigned char*>(previous_.data()),
+                             bytes_per_line_) == bytes_per_line_;
+}
+
+void LineSqueezer::prime(std::span<const std::byte> before_previous, std::span<const std::byte> previous) {
+    held_ = false;
+    have_previous_ = previous.size() == bytes_per_line_;
+    if (!have_previous_) return;
+
+    previous_printed_ = true;
+    if (before_previous.size() == bytes_per_line_) {
+        std::memcpy(previous_.data(), before_previous.data(), bytes_per_line_);
+        previous_printed_ = !repeats(previous);
+    }
+    std::memcpy(previous_.data(), previous.data(), bytes_per_line_);
+}
+
+char* LineSqueezer::render(std::span<const std::byte> line, std::uint64_t line_offset, char* out) {
+    if (repeats(line)) {
+        if (previous_printed_) {
+            *out++ = '*';
+            *out++ = '\n';
+        }
+        previous_printed_ = false;
+        held_ = true;
+        held_offset_ = line_offset;
+        return out;
+    }
+
+    held_ = false;
+    have_previous_ = line.size() == bytes_per_line_;
+    previous_printed_ = true;
+    if (have_previous_) std::memcpy(previous_.data(), line.data(), bytes_per_line_);
+    return formatter_.render_line(line, line_offset, out);
+}
+
+char* LineSqueezer::render_run(std::span<const std::byte> line, std::uint64_t begin, std::uint64_t end, char* out) {
+    out = render(line, begin, out);
+    // Lines between the first and the last would only repeat what the last one does
+    if (end - begin > bytes_per_line_) out = render(line, end - bytes_per_line_, out);
+    return out;
+}
+
+char* LineSqueezer::skip_hole(std::uint64_t begin, std::uint64_t end, char* out) {
+    std::fill(previous_.begin(), previous_.end(), std::byte{0});
+    have_previous_ = true;
+    previous_printed_ = true;
+    held_ = true;
+    held_offset_ = end - bytes_per_line_;
+    return formatter_.render_hole(begin, end, out);
+}
+
+char* LineSqueezer::finish(char* out) {
+    if (!held_) return out;
+    held_ = false;
+    return formatter_.render_line(previous_, held_offset_, out);
+}
+
+} // namespace hexview
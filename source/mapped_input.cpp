@@ -0,0 +1,110 @@
+#include "mapped_input.hpp"
+#include "config.hpp"
+#include "utils.hpp"
+#include <algorithm>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+namespace hexview {
+
+MappedInput::~MappedInput() {
+    unmap();
+#if !defined(_WIN32) && !defined(_WIN64)
+    if (fd_ >= 0) ::close(fd_);
+#endif
+}
+
+bool MappedInput::open(const std::string& path, std::uint64_t start, std::uint64_t length) {
+#if defined(_WIN32) || defined(_WIN64)
+    (void)path;
+    (void)start;
+    (void)length;
+    return false;
+#else
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) return false;
+
+    // Pipes, character devices and files that report no size (procfs) are streamed
+    const std::uint64_t size = seekable_size(fd_);
+    if (size == 0) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    end_ = range_end(size, start, length);
+
+    const std::uint64_t range = end_ > start ? end_ - start : 0;
+    if (range > HUGE_FILE_THRESHOLD) {
+        window_size_ = HUGE_FILE_MAP_WINDOW;
+        huge_pages_ = true;
+        drop_cache_ = true;
+    } else if (range > LARGE_FILE_THRESHOLD) {
+        window_size_ = LARGE_FILE_MAP_WINDOW;
+        huge_pages_ = true;
+    } else {
+        window_size_ = 0; // whole range in one mapping
+    }
+
+#  if defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(fd_, static_cast<off_t>(start), static_cast<off_t>(range), POSIX_FADV_SEQUENTIAL);
+#  endif
+    return true;
+#endif
+}
+
+std::span<const std::byte> MappedInput::map_window(std::uint64_t offset, std::size_t min_size) {
+#if defined(_WIN32) || defined(_WIN64)
+    (void)offset;
+    (void)min_size;
+    return {};
+#else
+    unmap();
+    if (fd_ < 0 || offset >= end_) return {};
+
+    const std::uint64_t page = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+    const std::uint64_t align = huge_pages_ ? HUGE_PAGE_SIZE : page;
+    const std::uint64_t begin = offset - offset % align;
+
+    std::uint64_t length = end_ - begin;
+    if (window_size_ != 0) {
+        length = std::min(length, std::max<std::uint64_t>(window_size_, offset - begin + min_size));
+    }
+
+    void* mem = ::mmap(nullptr, static_cast<std::size_t>(length), PROT_READ, MAP_PRIVATE,
+                       fd_, static_cast<off_t>(begin));
+    if (mem == MAP_FAILED) return {};
+
+    map_ = mem;
+    map_size_ = static_cast<std::size_t>(length);
+    map_offset_ = begin;
+
+    ::madvise(map_, map_size_, MADV_SEQUENTIAL);
+#  if defined(MADV_HUGEPAGE)
+    if (huge_pages_) ::madvise(map_, map_size_, MADV_HUGEPAGE);
+#  endif
+
+    const auto* data = static_cast<const std::byte*>(map_);
+    return { data + (offset - begin), static_cast<std::size_t>(length - (offset - begin)) };
+#endif
+}
+
+void MappedInput::unmap() {
+#if !defined(_WIN32) && !defined(_WIN64)
+    if (map_ == nullptr) return;
+    ::munmap(map_, map_size_);
+#  if defined(POSIX_FADV_DONTNEED)
+    if (drop_cache_) {
+        ::posix_fadvise(fd_, static_cast<off_t>(map_offset_), static_cast<off_t>(map_size_), POSIX_FADV_DONTNEED);
+    }
+#  endif
+    map_ = nullptr;
+    map_size_ = 0;
+#endif
+}
+
+} // namespace hexview
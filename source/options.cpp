@@ -7,6 +7,7 @@
 #include <iostream>
 #include <stdexcept>
 #include <cstdlib>
+#include <thread>
 
 #if defined(_WIN32) || defined(_WIN64)
 #  include <io.h>
@@ -29,6 +30,136 @@ void Options::validate() {
         show_non_printable_as_dot = false;
     }
 
+    if (encoding != Encoding::Hex && style != Style::Dump) {
+        throw std::invalid_argument("--bits and --octal cannot be combined with --plain or --include");
+    }
+
+    if (word != 1 && word != 2 && word != 4 && word != 8) {
+        throw std::invalid_argument("word size must be 1, 2, 4 or 8");
+    }
+
+    if (word > 1 && (encoding != Encoding::Hex || style != Style::Dump)) {
+        throw std::invalid_argument("--word needs hex dump lines (no --bits, --octal, --plain or --include)");
+    }
+
+    if (word_values != WordValues::None && word == 1) {
+        throw std::invalid_argument("--values needs --word 2, 4 or 8");
+    }
+
+    if (word_values == WordValues::Float && word == 2) {
+        throw std::invalid_argument("--values float needs --word 4 or 8");
+    }
+
+    if (reverse && word > 1) {
+        throw std::invalid_argument("a --word dump cannot be reversed");
+    }
+
+    if (reverse && encoding != Encoding::Hex) {
+        throw std::invalid_argument("only hex dumps can be reversed");
+    }
+
+    if (diff && (filename.empty() || diff_filename.empty())) {
+        throw std::invalid_argument("--diff needs two inputs");
+    }
+
+    if (diff && filename == "-" && diff_filename == "-") {
+        throw std::invalid_argument("--diff can read only one input from stdin");
+    }
+
+    if (diff && (reverse || style != Style::Dump)) {
+        throw std::invalid_argument("--diff cannot be combined with --reverse, --plain or --include");
+    }
+
+    if (!find.empty() && (reverse || diff || style != Style::Dump)) {
+        throw std::invalid_argument("--find cannot be combined with --reverse, --diff, --plain or --include");
+    }
+
+    if (!signatures.empty() && (reverse || diff || !find.empty() || style != Style::Dump)) {
+        throw std::invalid_argument("--signatures cannot be combined with --reverse, --diff, --find, --plain or --include");
+    }
+
+    if (strings != 0 && (reverse || diff || !find.empty() || !signatures.empty() || style != Style::Dump)) {
+        throw std::invalid_argument("--strings cannot be combined with --reverse, --diff, --find, --signatures, --plain or --include");
+    }
+
+    if (entropy != 0 && (reverse || diff || !find.empty() || !signatures.empty() || strings != 0 || style != Style::Dump)) {
+        throw std::invalid_argument("--entropy cannot be combined with --reverse, --diff, --find, --signatures, --strings, --plain or --include");
+    }
+
+    if (checksum != Checksum::None &&
+        (reverse || diff || !find.empty() || !signatures.empty() || strings != 0 || entropy != 0 || style != Style::Dump)) {
+        throw std::invalid_argument("--checksum cannot be combined with --reverse, --diff, --find, --signatures, --strings, --entropy, --plain or --include");
+    }
+
+    if ((checksum_block != 0 || annotate) && checksum == Checksum::None) {
+        throw std::invalid_argument("--block and --annotate need --checksum");
+    }
+
+    if (summary && (reverse || diff || !find.empty() || !signatures.empty() || strings != 0 || entropy != 0 ||
+                    checksum != Checksum::None || style != Style::Dump)) {
+        throw std::invalid_argument("--summary cannot be combined with --reverse, --diff, --find, --signatures, --strings, --entropy, --checksum, --plain or --include");
+    }
+
+    if (interactive && (reverse || diff || !signatures.empty() || strings != 0 || entropy != 0 ||
+                        checksum != Checksum::None || summary || style != Style::Dump || !output.empty())) {
+        throw std::invalid_argument("--interactive cannot be combined with --reverse, --diff, --signatures, --strings, --entropy, --checksum, --summary, --plain, --include or --output");
+    }
+
+    if ((index || summary || next_data) && (reverse || diff)) {
+        throw std::invalid_argument("--index, --summary and --next-data cannot be combined with --reverse or --diff");
+    }
+
+    if (utf16 && strings == 0) {
+        throw std::invalid_argument("--utf16 needs --strings");
+    }
+
+    if (context != 0 && find.empty()) {
+        throw std::invalid_argument("--context needs --find or --find-text");
+    }
+
+    if (side_by_side && !diff) {
+        throw std::invalid_argument("--side-by-side needs --diff");
+    }
+
+    if (reverse && style == Style::Include) {
+        throw std::invalid_argument("a C include array cannot be reversed");
+    }
+
+    if (bytes_per_line == 0) {
+        if (style == Style::Plain) bytes_per_line = DEFAULT_PLAIN_BYTES_PER_LINE;
+        else if (style == Style::Include) bytes_per_line = DEFAULT_INCLUDE_BYTES_PER_LINE;
+        else if (encoding == Encoding::Bits) bytes_per_line = DEFAULT_BITS_BYTES_PER_LINE;
+        else bytes_per_line = DEFAULT_BYTES_PER_LINE;
+    }
+
+    if (checksum != Checksum::None && checksum_block == 0) {
+        checksum_block = DEFAULT_CHECKSUM_BLOCK;
+    }
+
+    if (annotate && checksum_block % bytes_per_line != 0) {
+        throw std::invalid_argument("--annotate needs a --block size that is a multiple of bytes-per-line");
+    }
+
+    if (bytes_per_line % word != 0) {
+        throw std::invalid_argument("bytes-per-line must be a multiple of the word size");
+    }
+
+    if (reverse && ascii_only) {
+        throw std::invalid_argument("an --ascii-only dump cannot be reversed");
+    }
+
+    if (reverse && swap_columns && show_escapes) {
+        throw std::invalid_argument("a --swap-columns dump with --show-escapes cannot be reversed");
+    }
+
+    if (queue_depth > MAX_READ_QUEUE_DEPTH) {
+        queue_depth = MAX_READ_QUEUE_DEPTH;
+    }
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
     if (filename.empty()) {
         // If stdin is not a TTY or not interactive, use stdin
         if (!stdout_is_tty() || !::isatty(FILENO_STDIN)) {
@@ -47,7 +178,7 @@ void print_help_and_exit(const char* program_name) {
     std::cout << "Usage: " << program_name << " [options] <file>\n\n"
               << "If <file> is '-' read from stdin.\n\n"
               << "Options:\n"
-              << "  -n, --bytes-per-line N      Bytes per line (default 16)\n"
+              << "  -n, --bytes-per-line N      Bytes per line (default 16, 30 with -p, 12 with -i, 6 with -b)\n"
               << "  -g, --group G               Grouping of bytes for spacing (default 1)\n"
               << "  -o, --offset-width W        Offset width in hex digits when using hex offsets (default 8)\n"
               << "  -s, --start OFFSET          Start offset (decimal or 0x hex) (default 0)\n"
@@ -61,12 +192,51 @@ void print_help_and_exit(const char* program_name) {
               << "  --offset-format hex|dec     Show offsets in hex (default) or decimal\n"
               << "  --no-offset                 Hide the offset/address column\n"
               << "  --show-escapes              Show control escapes (\\n, \\r, \\t) and \\xHH for others\n"
+              << "  -b, --bits                  Show each byte as 8 binary digits instead of hex\n"
+              << "  --octal                     Show each byte as 3 octal digits instead of hex\n"
+              << "  --word 2|4|8                Show each group of 2, 4 or 8 bytes as one hex word\n"
+              << "  --endian little|big         Byte order of --word words (default little)\n"
+              << "  --values dec|float          Add a column with each word as unsigned decimal or float\n"
+              << "  -p, --plain                 Plain continuous hex, no offsets or ASCII column\n"
+              << "  -i, --include               C include file style array with a length symbol\n"
+              << "  -v, --no-squeeze            Show every line instead of replacing repeats with '*'\n"
+              << "  --vmsplice                  Gift output pages to a stdout pipe (Linux)\n"
+              << "  --output FILE               Write the dump to FILE instead of stdout\n"
+              << "  --pipeline                  Read, format and write on separate threads (any input)\n"
+              << "  --queue-depth N             Read files with N reads in flight (io_uring; 0 = memory map)\n"
+              << "  --threads N                 Render seekable inputs on N threads (0 = one per CPU)\n"
+              << "  -r, --reverse               Turn a dump or plain hex back into binary (give the dump's layout options)\n"
+              << "  --diff A B                  Show only the lines where A and B differ\n"
+              << "  --side-by-side              Show --diff lines side by side instead of interleaved\n"
+              << "  --find HEX                  Dump only the lines holding a hex pattern (?? = any byte)\n"
+              << "  --find-text TEXT            Dump only the lines holding a text pattern (? = any byte)\n"
+              << "  -C, --context N             Lines shown before and after each match\n"
+              << "  --signatures FILE           List every occurrence of the named patterns in FILE\n"
+              << "  --strings[=MIN]             List printable strings of at least MIN characters (default 4)\n"
+              << "  --utf16                     With --strings, list UTF-16LE strings too\n"
+              << "  --entropy BLOCK             Summarize the byte entropy of every BLOCK bytes\n"
+              << "  --checksum ALGO             List a checksum of every block (crc32c|xxh64)\n"
+              << "  --block N                   Bytes per --checksum block (default 4096)\n"
+              << "  --annotate                  With --checksum, dump the input and append each checksum to the line ending its block\n"
+              << "  --index[=PATH]              Use a sidecar block index (default FILE.hvidx), building it if needed\n"
+              << "  --summary                   List runs of zero, fill, text, random and other blocks from the index\n"
+              << "  --next-data                 Start at the first block at or after the start offset that is not one repeated byte\n"
+              << "  --interactive               Browse the input in a full-screen pager (keys: j/k, space/b, g, /, s, n, q)\n"
               << "  -h, --help                  Show this help and exit\n"
               << "  --version                   Print version and exit\n\n"
               << "Examples:\n"
               << "  " << program_name << " file.bin\n"
               << "  " << program_name << " -n 8 -g 2 -u -c off file.bin\n"
-              << "  cat file.bin | " << program_name << " -\n";
+              << "  cat file.bin | " << program_name << " -\n"
+              << "  " << program_name << " -r --output file.bin dump.txt\n"
+              << "  " << program_name << " --diff old.img new.img\n"
+              << "  " << program_name << " --find 'de ad ?? ef' -C 2 file.bin\n"
+              << "  " << program_name << " --signatures magic.txt --threads 0 disk.img\n"
+              << "  " << program_name << " --strings=8 --utf16 -s 0x1000 firmware.bin\n"
+              << "  " << program_name << " --entropy 0x10000 --threads 0 firmware.bin\n"
+              << "  " << program_name << " --checksum crc32c --block 0x100000 disk.img\n"
+              << "  " << program_name << " --summary --threads 0 disk.img\n"
+              << "  " << program_name << " --interactive --find-text 'BOOT' disk.img\n";
     std::exit(0);
 }
 
@@ -136,8 +306,123 @@ Options parse_arguments(int argc, char* argv[]) {
         } else if (a == "--show-escapes") {
             opt.show_escapes = true;
             opt.show_non_printable_as_dot = false;
-        } else if (!a.empty() && a[0] == '-') {
+        } else if (a == "-b" || a == "--bits") {
+            opt.encoding = Options::Encoding::Bits;
+        } else if (a == "--octal") {
+            opt.encoding = Options::Encoding::Octal;
+        } else if (a == "--word") {
+            if (i + 1 >= argc) throw std::invalid_argument(a + " requires a value: 2|4|8");
+            int val = std::stoi(argv[++i]);
+            if (val <= 0) throw std::invalid_argument("word size must be positive");
+            opt.word = static_cast<std::size_t>(val);
+        } else if (a == "--endian") {
+            if (i + 1 >= argc) throw std::invalid_argument(a + " requires a value: little|big");
+            std::string v = argv[++i];
+            std::transform(v.begin(), v.end(), v.begin(),
+                          [](unsigned char ch){ return static_cast<char>(std::tolower(ch)); });
+            if (v == "little") opt.endian = Options::Endian::Little;
+            else if (v == "big") opt.endian = Options::Endian::Big;
+            else throw std::invalid_argument("invalid endian: " + v);
+        } else if (a == "--values") {
+            if (i + 1 >= argc) throw std::invalid_argument(a + " requires a value: dec|float");
+            std::string v = argv[++i];
+            std::transform(v.begin(), v.end(), v.begin(),
+                          [](unsigned char ch){ return static_cast<char>(std::tolower(ch)); });
+            if (v == "dec") opt.word_values = Options::WordValues::Dec;
+            else if (v == "float") opt.word_values = Options::WordValues::Float;
+            else throw std::invalid_argument("invalid values: " + v);
+        } else if (a == "-p" || a == "--plain") {
+            opt.style = Options::Style::Plain;
+        } else if (a == "-i" || a == "--include") {
+            opt.style = Options::Style::Include;
+        } else if (a == "-v" || a == "--no-squeeze") {
+            opt.squeeze = false;
+        } else if (a == "--vmsplice") {
+            opt.vmsplice = true;
+        } else if (a == "--output") {
+            if (i + 1 >= argc) throw std::invalid_argument(a + " requires a value");
+            opt.output = argv[++i];
+        } else if (a == "--pipeline") {
+            opt.pipeline = true;
+        } else if (a == "--queue-depth") {
+            if (i + 1 >= argc) throw std::invalid_argument(a + " requires a value");
+            int val = std::stoi(argv[++i]);
+            if (val < 0) throw std::invalid_argument("queue depth must not be negative");
+            opt.queue_depth = static_cast<std::size_t>(val);
+        } else if (a == "--threads") {
+            if (i + 1 >= argc) throw std::invalid_argument(a + " requires a value");
+            int val = std::stoi(argv[++i]);
+            if (val < 0) throw std::invalid_argument("threads must not be negative");
+            opt.threads = static_cast<std::size_t>(val);
+        } else if (a == "-r" || a == "--reverse") {
+            opt.reverse = true;
+        } else if (a == "--diff") {
+            opt.diff = true;
+        } else if (a == "--side-by-side") {
+            opt.side_by_side = true;
+        } else if (a == "--find" || a == "--find-text") {
+            if (i + 1 >= argc) throw std::invalid_argument(a + " requires a pattern");
+            if (!opt.find.empty()) throw std::invalid_argument("only one --find or --find-text pattern can be given");
+            opt.find = argv[++i];
+            opt.find_text = a == "--find-text";
+            if (opt.find.empty()) throw std::invalid_argument("empty search pattern");
+        } else if (a == "--strings" || a.rfind("--strings=", 0) == 0) {
+            // The minimum length is optional, so it is only taken in --strings=MIN form
+            const std::size_t eq = a.find('=');
+            opt.strings = DEFAULT_STRINGS_MIN;
+            if (eq != std::string::npos) {
+                int val = std::stoi(a.substr(eq + 1));
+                if (val <= 0) throw std::invalid_argument("strings minimum length must be positive");
+                opt.strings = static_cast<std::size_t>(val);
+            }
+        } else if (a == "--utf16") {
+            opt.utf16 = true;
+        } else if (a == "--signatures") {
+            if (i + 1 >= argc) throw std::invalid_argument(a + " requires a file name");
+            opt.signatures = argv[++i];
+        } else if (a == "--entropy") {
+            if (i + 1 >= argc) throw std::invalid_argument(a + " requires a block size");
+            const std::uint64_t val = parse_uint64(argv[++i]);
+            if (val == 0) throw std::invalid_argument("entropy block size must be positive");
+            opt.entropy = static_cast<std::size_t>(val);
+        } else if (a == "--checksum") {
+            if (i + 1 >= argc) throw std::invalid_argument(a + " requires a value: crc32c|xxh64");
+            std::string v = argv[++i];
+            std::transform(v.begin(), v.end(), v.begin(),
+                          [](unsigned char ch){ return static_cast<char>(std::tolower(ch)); });
+            if (v == "crc32c") opt.checksum = Options::Checksum::Crc32c;
+            else if (v == "xxh64") opt.checksum = Options::Checksum::Xxh64;
+            else throw std::invalid_argument("invalid checksum: " + v);
+        } else if (a == "--block") {
+            if (i + 1 >= argc) throw std::invalid_argument(a + " requires a size");
+            const std::uint64_t val = parse_uint64(argv[++i]);
+            if (val == 0) throw std::invalid_argument("checksum block size must be positive");
+            opt.checksum_block = static_cast<std::size_t>(val);
+        } else if (a == "--annotate") {
+            opt.annotate = true;
+        } else if (a == "--index" || a.rfind("--index=", 0) == 0) {
+            // The sidecar path is optional, so it is only taken in --index=PATH form
+            const std::size_t eq = a.find('=');
+            opt.index = true;
+            if (eq != std::string::npos) {
+                opt.index_file = a.substr(eq + 1);
+                if (opt.index_file.empty()) throw std::invalid_argument("--index= requires a file name");
+            }
+        } else if (a == "--summary") {
+            opt.summary = true;
+        } else if (a == "--next-data") {
+            opt.next_data = true;
+        } else if (a == "--interactive") {
+            opt.interactive = true;
+        } else if (a == "-C" || a == "--context") {
+            if (i + 1 >= argc) throw std::invalid_argument(a + " requires a value");
+            int val = std::stoi(argv[++i]);
+            if (val < 0) throw std::invalid_argument("context must not be negative");
+            opt.context = static_cast<std::size_t>(val);
+        } else if (a != "-" && !a.empty() && a[0] == '-') {
             throw std::invalid_argument("unknown option: " + a);
+        } else if (opt.diff && !opt.filename.empty()) {
+            opt.diff_filename = a;
         } else {
             opt.filename = a;
         }
@@ -40,10 +40,32 @@ void OptionsParser::setup_options() {
     app_options_.add_option("--swap-columns", "Print ASCII column first, hex column second", false);
     app_options_.add_option("--no-offset", "Hide the offset/address column", false);
     app_options_.add_option("--show-escapes", "Show control escapes (\\n, \\r, \\t) and \\xHH for others", false);
+    app_options_.add_option("-b", "Show each byte as 8 binary digits instead of hex", false);
+    app_options_.add_option("--bits", "Show each byte as 8 binary digits instead of hex", false);
+    app_options_.add_option("--octal", "Show each byte as 3 octal digits instead of hex", false);
+    app_options_.add_option("-p", "Plain continuous hex, no offsets or ASCII column", false);
+    app_options_.add_option("--plain", "Plain continuous hex, no offsets or ASCII column", false);
+    app_options_.add_option("-i", "C include file style array with a length symbol", false);
+    app_options_.add_option("--include", "C include file style array with a length symbol", false);
+    app_options_.add_option("-v", "Show every line instead of replacing repeats with '*'", false);
+    app_options_.add_option("--no-squeeze", "Show every line instead of replacing repeats with '*'", false);
+    app_options_.add_option("--vmsplice", "Gift output pages to a stdout pipe (Linux)", false);
+    app_options_.add_option("--pipeline", "Read, format and write on separate threads (any input)", false);
+    app_options_.add_option("-r", "Turn a dump or plain hex back into binary (give the dump's layout options)", false);
+    app_options_.add_option("--reverse", "Turn a dump or plain hex back into binary (give the dump's layout options)", false);
+    app_options_.add_option("--diff", "Show only the lines where two inputs differ (give both as arguments)", false);
+    app_options_.add_option("--side-by-side", "Show --diff lines side by side instead of interleaved", false);
+    app_options_.add_option("--strings", "List printable strings (--strings=MIN sets the shortest, default 4)", false);
+    app_options_.add_option("--utf16", "With --strings, list UTF-16LE strings too", false);
+    app_options_.add_option("--annotate", "With --checksum, dump the input and append each checksum to the line ending its block", false);
+    app_options_.add_option("--index", "Use a sidecar block index, building it if needed (--index=PATH names the sidecar)", false);
+    app_options_.add_option("--summary", "List runs of zero, fill, text, random and other blocks from the index", false);
+    app_options_.add_option("--interactive", "Browse the input in a full-screen pager (keys: j/k, space/b, g, /, s, n, q)", false);
+    app_options_.add_option("--next-data", "Start at the first block at or after the start offset that is not one repeated byte", false);
 
     // Options that take values
-    app_options_.add_option("-n", "Bytes per line (default 16)", true);
-    app_options_.add_option("--bytes-per-line", "Bytes per line (default 16)", true);
+    app_options_.add_option("-n", "Bytes per line (default 16, 30 with -p, 12 with -i, 6 with -b)", true);
+    app_options_.add_option("--bytes-per-line", "Bytes per line (default 16, 30 with -p, 12 with -i, 6 with -b)", true);
     app_options_.add_option("-g", "Grouping of bytes for spacing (default 1)", true);
     app_options_.add_option("--group", "Grouping of bytes for spacing (default 1)", true);
     app_options_.add_option("-o", "Offset width in hex digits when using hex offsets (default 8)", true);
@@ -55,6 +77,20 @@ void OptionsParser::setup_options() {
     app_options_.add_option("-c", "Colorize output (on|off|auto - auto = only when stdout is a TTY)", true);
     app_options_.add_option("--color", "Colorize output (on|off|auto - auto = only when stdout is a TTY)", true);
     app_options_.add_option("--offset-format", "Show offsets in hex (default) or decimal", true);
+    app_options_.add_option("--word", "Show each group of 2, 4 or 8 bytes as one hex word", true);
+    app_options_.add_option("--endian", "Byte order of --word words (little|big, default little)", true);
+    app_options_.add_option("--values", "Add a column with each word as unsigned decimal or float (dec|float)", true);
+    app_options_.add_option("--find", "Dump only the lines holding a hex pattern (?? = any byte)", true);
+    app_options_.add_option("--find-text", "Dump only the lines holding a text pattern (? = any byte)", true);
+    app_options_.add_option("-C", "Lines shown before and after each match", true);
+    app_options_.add_option("--context", "Lines shown before and after each match", true);
+    app_options_.add_option("--signatures", "List every occurrence of the named patterns in FILE", true);
+    app_options_.add_option("--entropy", "Summarize the byte entropy of every BLOCK bytes", true);
+    app_options_.add_option("--checksum", "List a checksum of every block (crc32c|xxh64)", true);
+    app_options_.add_option("--block", "Bytes per --checksum block (default 4096)", true);
+    app_options_.add_option("--output", "Write the dump to FILE instead of stdout", true);
+    app_options_.add_option("--queue-depth", "Read files with N reads in flight (io_uring; 0 = memory map)", true);
+    app_options_.add_option("--threads", "Render seekable inputs on N threads (0 = one per CPU)", true);
 }
 
 Options OptionsParser::parse(int argc, char* argv[]) {
@@ -124,6 +160,86 @@ Options OptionsParser::convert_to_options(const char* program_name) {
         }
     }
 
+    if (app_options_.has_option("--word")) {
+        std::string val = app_options_.get("--word");
+        if (!val.empty()) {
+            int parsed_val = std::stoi(val);
+            if (parsed_val <= 0) throw std::invalid_argument("word size must be positive");
+            opt.word = static_cast<std::size_t>(parsed_val);
+        }
+    }
+
+    if (app_options_.has_option("--find") || app_options_.has_option("--find-text")) {
+        if (app_options_.has_option("--find") && app_options_.has_option("--find-text")) {
+            throw std::invalid_argument("options --find and --find-text are mutually exclusive");
+        }
+        opt.find_text = app_options_.has_option("--find-text");
+        opt.find = app_options_.get(opt.find_text ? "--find-text" : "--find");
+        if (opt.find.empty()) throw std::invalid_argument("empty search pattern");
+    }
+
+    if (app_options_.has_option("-C") || app_options_.has_option("--context")) {
+        std::string val = app_options_.get("-C", app_options_.get("--context"));
+        if (!val.empty()) {
+            int parsed_val = std::stoi(val);
+            if (parsed_val < 0) throw std::invalid_argument("context must not be negative");
+            opt.context = static_cast<std::size_t>(parsed_val);
+        }
+    }
+
+    if (app_options_.has_option("--signatures")) {
+        opt.signatures = app_options_.get("--signatures");
+        if (opt.signatures.empty()) throw std::invalid_argument("--signatures requires a file name");
+    }
+
+    if (app_options_.has_option("--entropy")) {
+        std::string val = app_options_.get("--entropy");
+        if (val.empty()) throw std::invalid_argument("--entropy requires a block size");
+        const std::uint64_t parsed_val = parse_uint64(val);
+        if (parsed_val == 0) throw std::invalid_argument("entropy block size must be positive");
+        opt.entropy = static_cast<std::size_t>(parsed_val);
+    }
+
+    if (app_options_.has_option("--checksum")) {
+        std::string val = app_options_.get("--checksum");
+        std::transform(val.begin(), val.end(), val.begin(),
+                      [](unsigned char ch){ return static_cast<char>(std::tolower(ch)); });
+        if (val == "crc32c") opt.checksum = Options::Checksum::Crc32c;
+        else if (val == "xxh64") opt.checksum = Options::Checksum::Xxh64;
+        else throw std::invalid_argument("invalid checksum: " + val);
+    }
+
+    if (app_options_.has_option("--block")) {
+        std::string val = app_options_.get("--block");
+        if (val.empty()) throw std::invalid_argument("--block requires a size");
+        const std::uint64_t parsed_val = parse_uint64(val);
+        if (parsed_val == 0) throw std::invalid_argument("checksum block size must be positive");
+        opt.checksum_block = static_cast<std::size_t>(parsed_val);
+    }
+
+    if (app_options_.has_option("--output")) {
+        opt.output = app_options_.get("--output");
+        if (opt.output.empty()) throw std::invalid_argument("--output requires a file name");
+    }
+
+    if (app_options_.has_option("--queue-depth")) {
+        std::string val = app_options_.get("--queue-depth");
+        if (!val.empty()) {
+            int parsed_val = std::stoi(val);
+            if (parsed_val < 0) throw std::invalid_argument("queue depth must not be negative");
+            opt.queue_depth = static_cast<std::size_t>(parsed_val);
+        }
+    }
+
+    if (app_options_.has_option("--threads")) {
+        std::string val = app_options_.get("--threads");
+        if (!val.empty()) {
+            int parsed_val = std::stoi(val);
+            if (parsed_val < 0) throw std::invalid_argument("threads must not be negative");
+            opt.threads = static_cast<std::size_t>(parsed_val);
+        }
+    }
+
     // Boolean flags
     if (app_options_.has_option("-u") || app_options_.has_option("--uppercase")) {
         opt.uppercase = true;
@@ -150,6 +266,85 @@ Options OptionsParser::convert_to_options(const char* program_name) {
         opt.show_non_printable_as_dot = false;
     }
 
+    if (app_options_.has_option("-b") || app_options_.has_option("--bits")) {
+        if (app_options_.has_option("--octal")) {
+            throw std::invalid_argument("options --bits and --octal are mutually exclusive");
+        }
+        opt.encoding = Options::Encoding::Bits;
+    } else if (app_options_.has_option("--octal")) {
+        opt.encoding = Options::Encoding::Octal;
+    }
+
+    if (app_options_.has_option("-p") || app_options_.has_option("--plain")) {
+        if (app_options_.has_option("-i") || app_options_.has_option("--include")) {
+            throw std::invalid_argument("options --plain and --include are mutually exclusive");
+        }
+        opt.style = Options::Style::Plain;
+    } else if (app_options_.has_option("-i") || app_options_.has_option("--include")) {
+        opt.style = Options::Style::Include;
+    }
+
+    if (app_options_.has_option("-v") || app_options_.has_option("--no-squeeze")) {
+        opt.squeeze = false;
+    }
+
+    if (app_options_.has_option("--vmsplice")) {
+        opt.vmsplice = true;
+    }
+
+    if (app_options_.has_option("--pipeline")) {
+        opt.pipeline = true;
+    }
+
+    if (app_options_.has_option("-r") || app_options_.has_option("--reverse")) {
+        opt.reverse = true;
+    }
+
+    if (app_options_.has_option("--diff")) {
+        opt.diff = true;
+    }
+
+    if (app_options_.has_option("--side-by-side")) {
+        opt.side_by_side = true;
+    }
+
+    // --strings takes an optional minimum length in --strings=MIN form
+    if (app_options_.has_option("--strings")) {
+        std::string val = app_options_.get("--strings");
+        opt.strings = DEFAULT_STRINGS_MIN;
+        if (!val.empty()) {
+            int parsed_val = std::stoi(val);
+            if (parsed_val <= 0) throw std::invalid_argument("strings minimum length must be positive");
+            opt.strings = static_cast<std::size_t>(parsed_val);
+        }
+    }
+
+    if (app_options_.has_option("--utf16")) {
+        opt.utf16 = true;
+    }
+
+    if (app_options_.has_option("--annotate")) {
+        opt.annotate = true;
+    }
+
+    // --index takes an optional sidecar path in --index=PATH form
+    if (app_options_.has_option("--index")) {
+        opt.index = true;
+        opt.index_file = app_options_.get("--index");
+    }
+
+    if (app_options_.has_option("--summary")) {
+        opt.summary = true;
+    }
+
+    if (app_options_.has_option("--next-data")) {
+        opt.next_data = true;
+    }
+
+    if (app_options_.has_option("--interactive")) {
+        opt.interactive = true;
+    }
+
     // Color handling
     if (app_options_.has_option("--no-color")) {
         opt.color = false;
@@ -177,11 +372,37 @@ Options OptionsParser::convert_to_options(const char* program_name) {
         }
     }
 
+    // Word byte order and value column
+    if (app_options_.has_option("--endian")) {
+        std::string val = app_options_.get("--endian");
+        if (!val.empty()) {
+            std::transform(val.begin(), val.end(), val.begin(),
+                          [](unsigned char ch){ return static_cast<char>(std::tolower(ch)); });
+            if (val == "little") opt.endian = Options::Endian::Little;
+            else if (val == "big") opt.endian = Options::Endian::Big;
+            else throw std::invalid_argument("invalid endian: " + val);
+        }
+    }
+
+    if (app_options_.has_option("--values")) {
+        std::string val = app_options_.get("--values");
+        if (!val.empty()) {
+            std::transform(val.begin(), val.end(), val.begin(),
+                          [](unsigned char ch){ return static_cast<char>(std::tolower(ch)); });
+            if (val == "dec") opt.word_values = Options::WordValues::Dec;
+            else if (val == "float") opt.word_values = Options::WordValues::Float;
+            else throw std::invalid_argument("invalid values: " + val);
+        }
+    }
+
     // Handle filename from positional arguments
     const auto& positional = app_options_.get_positional_args();
     if (!positional.empty()) {
         opt.filename = positional[0];
     }
+    if (opt.diff && positional.size() > 1) {
+        opt.diff_filename = positional[1];
+    }
 
     opt.validate();
     return opt;
@@ -0,0 +1,201 @@
+#include "output_sink.hpp"
+#include "config.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(_WIN32) || defined(_WIN64)
+#  include <io.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <sys/uio.h>
+#  include <unistd.h>
+#endif
+
+namespace hexview {
+
+OutputSink::OutputSink(int fd, bool use_vmsplice) : fd_(fd) {
+    std::size_t preferred = 0;
+    bool is_pipe = false;
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    struct stat st {};
+    if (::fstat(fd_, &st) == 0) {
+        if (S_ISFIFO(st.st_mode)) {
+            is_pipe = true;
+#  if defined(__linux__)
+            int pipe_size = ::fcntl(fd_, F_GETPIPE_SZ);
+            if (pipe_size > 0) preferred = static_cast<std::size_t>(pipe_size);
+#  endif
+        } else if (st.st_blksize > 0) {
+            preferred = static_cast<std::size_t>(st.st_blksize);
+        }
+    }
+#endif
+
+#if defined(__linux__)
+    vmsplice_ = use_vmsplice && is_pipe;
+#else
+    (void)use_vmsplice;
+    (void)is_pipe;
+#endif
+
+    capacity_ = calculate_output_buffer_size(preferred);
+    allocate_buffer();
+}
+
+OutputSink::~OutputSink() {
+    flush();
+    release_buffer();
+}
+
+void OutputSink::allocate_buffer() {
+#if defined(__linux__)
+    if (vmsplice_) {
+        void* mem = ::mmap(nullptr, capacity_, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem != MAP_FAILED) {
+            buffer_ = static_cast<char*>(mem);
+            mapped_ = true;
+            return;
+        }
+        vmsplice_ = false;
+    }
+#endif
+    buffer_ = new char[capacity_];
+    mapped_ = false;
+}
+
+void OutputSink::release_buffer() {
+    if (buffer_ == nullptr) return;
+#if defined(__linux__)
+    if (mapped_) {
+        ::munmap(buffer_, capacity_);
+        buffer_ = nullptr;
+        return;
+    }
+#endif
+    delete[] buffer_;
+    buffer_ = nullptr;
+}
+
+char* OutputSink::reserve(std::size_t size) {
+    if (used_ + size > capacity_) {
+        flush();
+        if (size > capacity_) {
+            release_buffer();
+            capacity_ = size;
+            allocate_buffer();
+        }
+    }
+    return buffer_ + used_;
+}
+
+void OutputSink::write(std::string_view data) {
+    if (used_ + data.size() <= capacity_) {
+        std::memcpy(buffer_ + used_, data.data(), data.size());
+        used_ += data.size();
+        return;
+    }
+    if (vmsplice_) {
+        // Gifted pages must come from our own buffer, so go through it
+        while (!data.empty()) {
+            std::size_t chunk = std::min(data.size(), capacity_ - used_);
+            std::memcpy(buffer_ + used_, data.data(), chunk);
+            used_ += chunk;
+            data.remove_prefix(chunk);
+            if (used_ == capacity_) flush();
+        }
+        return;
+    }
+    // Pending output and the new block go out together without copying
+    write_fully(std::string_view(buffer_, used_), data);
+    used_ = 0;
+}
+
+bool OutputSink::flush() {
+    if (used_ == 0 || failed_) {
+        used_ = 0;
+        return !failed_;
+    }
+
+    std::size_t done = 0;
+    if (vmsplice_) {
+        done = splice_buffer();
+    }
+    if (done < used_) {
+        write_fully(std::string_view(buffer_ + done, used_ - done));
+    }
+    if (done != 0) {
+        // The kernel now owns the gifted pages, so never write to them again
+        release_buffer();
+        allocate_buffer();
+    }
+    used_ = 0;
+    return !failed_;
+}
+
+std::size_t OutputSink::splice_buffer() {
+#if defined(__linux__)
+    std::size_t done = 0;
+    while (done < used_) {
+        struct iovec iov { buffer_ + done, used_ - done };
+        ssize_t n = ::vmsplice(fd_, &iov, 1, SPLICE_F_GIFT);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            // Not supported for this destination: fall back to write(2)
+            vmsplice_ = false;
+            break;
+        }
+        done += static_cast<std::size_t>(n);
+    }
+    return done;
+#else
+    return 0;
+#endif
+}
+
+void OutputSink::write_fully(std::string_view first, std::string_view second) {
+    if (failed_) return;
+
+#if defined(_WIN32) || defined(_WIN64)
+    for (std::string_view piece : {first, second}) {
+        while (!piece.empty()) {
+            unsigned int chunk = static_cast<unsigned int>(std::min<std::size_t>(piece.size(), 1u << 30));
+            int n = ::_write(fd_, piece.data(), chunk);
+            if (n <= 0) {
+                failed_ = true;
+                return;
+            }
+            piece.remove_prefix(static_cast<std::size_t>(n));
+        }
+    }
+#else
+    while (!first.empty() || !second.empty()) {
+        struct iovec iov[2];
+        int count = 0;
+        if (!first.empty()) {
+            iov[count++] = { const_cast<char*>(first.data()), first.size() };
+        }
+        if (!second.empty()) {
+            iov[count++] = { const_cast<char*>(second.data()), second.size() };
+        }
+
+        ssize_t n = ::writev(fd_, iov, count);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            failed_ = true;
+            return;
+        }
+
+        std::size_t written = static_cast<std::size_t>(n);
+        std::size_t from_first = std::min(written, first.size());
+        first.remove_prefix(from_first);
+        second.remove_prefix(written - from_first);
+    }
+#endif
+}
+
+} // namespace hexview
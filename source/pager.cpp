@@ -0,0 +1,560 @@
+#include "pager.hpp"
+#include "config.hpp"
+#include "thread_pool.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#  include <fcntl.h>
+#  include <poll.h>
+#  include <sys/ioctl.h>
+#  include <sys/stat.h>
+#  include <termios.h>
+#  include <unistd.h>
+#endif
+
+namespace hexview {
+
+namespace {
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+constexpr int ESCAPE_TIMEOUT_MS = 25;       // wait for the rest of an escape sequence
+
+volatile std::sig_atomic_t resized = 0;
+
+extern "C" void on_resize(int) {
+    resized = 1;
+}
+
+/**
+ * @brief Keys the pager reacts to
+ */
+enum class Key { None, Char, Up, Down, PageUp, PageDown, Home, End, Escape, Enter, Backspace };
+
+/**
+ * @brief Write a whole string to the terminal
+ */
+void write_all(std::string_view text) {
+    while (!text.empty()) {
+        ssize_t n = ::write(STDOUT_FILENO, text.data(), text.size());
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        text.remove_prefix(static_cast<std::size_t>(n));
+    }
+}
+
+/**
+ * @brief Raw keyboard input and the alternate screen, restored when destroyed
+ *
+ * Output post-processing stays on, so "\n" still moves to the start of
+ * the next line. Line wrapping is turned off so long dump lines are cut
+ * at the screen edge instead of scrolling the screen.
+ */
+class TerminalMode {
+public:
+    bool enter() {
+        if (::tcgetattr(STDIN_FILENO, &saved_) != 0) return false;
+        termios raw = saved_;
+        raw.c_lflag &= ~static_cast<tcflag_t>(ICANON | ECHO | IEXTEN | ISIG);
+        raw.c_iflag &= ~static_cast<tcflag_t>(IXON | ICRNL);
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        if (::tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw) != 0) return false;
+
+        // No SA_RESTART, so a resize interrupts the blocking key read
+        struct sigaction action {};
+        action.sa_handler = on_resize;
+        sigemptyset(&action.sa_mask);
+        ::sigaction(SIGWINCH, &action, &saved_action_);
+
+        active_ = true;
+        write_all("\x1b[?1049h\x1b[?25l\x1b[?7l");
+        return true;
+    }
+
+    ~TerminalMode() {
+        if (!active_) return;
+        write_all("\x1b[?7h\x1b[?25h\x1b[?1049l");
+        ::sigaction(SIGWINCH, &saved_action_, nullptr);
+        ::tcsetattr(STDIN_FILENO, TCSAFLUSH, &saved_);
+    }
+
+private:
+    termios saved_ {};
+    struct sigaction saved_action_ {};
+    bool active_ = false;
+};
+
+/**
+ * @brief Read one byte of input, waiting at most timeout_ms (-1 = forever)
+ * @return false on timeout, on a signal and at end of input
+ */
+bool read_byte(char& c, int timeout_ms) {
+    if (timeout_ms >= 0) {
+        pollfd fd{ STDIN_FILENO, POLLIN, 0 };
+        if (::poll(&fd, 1, timeout_ms) <= 0) return false;
+    }
+    return ::read(STDIN_FILENO, &c, 1) == 1;
+}
+
+/**
+ * @brief Read a key, decoding the escape sequences of the cursor keys
+ * @param c Receives the character of a Key::Char
+ * @param timeout_ms Time to wait for the key (-1 = forever)
+ * @return Key::None on timeout, on a signal or for an unknown sequence
+ */
+Key read_key(char& c, int timeout_ms = -1) {
+    if (!read_byte(c, timeout_ms)) return Key::None;
+    switch (c) {
+    case '\r': case '\n': return Key::Enter;
+    case 0x7F: case 0x08: return Key::Backspace;
+    case 0x1B: break;
+    default: return Key::Char;
+    }
+
+    // A lone Esc is not followed by the rest of a sequence
+    char kind;
+    if (!read_byte(kind, ESCAPE_TIMEOUT_MS)) return Key::Escape;
+    if (kind != '[' && kind != 'O') return Key::None;
+    std::string sequence;
+    char next;
+    while (read_byte(next, ESCAPE_TIMEOUT_MS)) {
+        sequence += next;
+        if (next >= 0x40 && next <= 0x7E) break;
+    }
+    if (sequence == "A") return Key::Up;
+    if (sequence == "B") return Key::Down;
+    if (sequence == "H" || sequence == "1~" || sequence == "7~") return Key::Home;
+    if (sequence == "F" || sequence == "4~" || sequence == "8~") return Key::End;
+    if (sequence == "5~") return Key::PageUp;
+    if (sequence == "6~") return Key::PageDown;
+    return Key::None;
+}
+
+#endif
+
+} // namespace
+
+Pager::Pager(const Options& options, const Formatter& formatter)
+    : options_(options),
+      formatter_(formatter),
+      kernels_(hex_kernels()) {
+    if (!options.find.empty()) {
+        set_pattern(options.find_text ? SearchPattern::from_text(options.find) : SearchPattern::from_hex(options.find));
+    }
+}
+
+void Pager::set_pattern(SearchPattern pattern) {
+    // Same filter anchors as --find: the first and last bytes without wildcards
+    const std::size_t size = pattern.value.size();
+    if (size == 0) throw std::invalid_argument("empty search pattern");
+    std::size_t first = size;
+    std::size_t last = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        if (pattern.mask[i] != 0xFF) continue;
+        if (first == size) first = i;
+        last = i;
+    }
+    if (first == size) throw std::invalid_argument("search pattern needs at least one byte without wildcards");
+    pattern_ = std::move(pattern);
+    first_ = first;
+    last_ = last;
+}
+
+std::uint64_t Pager::line_of(std::uint64_t offset) const {
+    const std::size_t BPL = options_.bytes_per_line;
+    if (end_ <= options_.start) return options_.start;
+    offset = std::clamp(offset, options_.start, end_ - 1);
+    return offset - (offset - options_.start) % BPL;
+}
+
+std::uint64_t Pager::last_top() const {
+    const std::uint64_t last_line = line_of(end_);
+    const std::uint64_t above = page_bytes() - options_.bytes_per_line;
+    return last_line - options_.start > above ? last_line - above : options_.start;
+}
+
+Pager::Page Pager::render_page(std::uint64_t top, const Layout& layout) const {
+    Page page;
+    page.top = top;
+    page.generation = layout.generation;
+#if !defined(_WIN32) && !defined(_WIN64)
+    const std::size_t BPL = options_.bytes_per_line;
+    const std::uint64_t want = top < end_ ? std::min<std::uint64_t>(end_ - top, layout.rows * BPL) : 0;
+    std::vector<std::byte> data(static_cast<std::size_t>(want));
+    const std::size_t got = read_at(fd_, data.data(), data.size(), top, page.error);
+    page.error_offset = top + got;
+
+    static constexpr std::string_view EOL = "\x1b[K\n";
+    std::string& text = page.text;
+    text.resize(layout.rows * (formatter_.max_line_size() + EOL.size()));
+    char* const begin = text.data();
+    char* out = begin;
+    std::vector<std::uint8_t> marks(BPL);
+    for (std::size_t row = 0, pos = 0; row < layout.rows; ++row, pos += BPL) {
+        if (pos < got) {
+            const auto line = std::span<const std::byte>(data).subspan(pos, std::min(BPL, got - pos));
+            const std::uint64_t offset = top + pos;
+            if (layout.match_begin < offset + line.size() && layout.match_end > offset) {
+                for (std::size_t i = 0; i < line.size(); ++i) {
+                    marks[i] = offset + i >= layout.match_begin && offset + i < layout.match_end;
+                }
+                out = formatter_.render_marked_line(line, std::span<const std::uint8_t>(marks).first(line.size()), offset, out);
+            } else {
+                out = formatter_.render_line(line, offset, out);
+            }
+            --out;  // the line's newline goes after the erase
+        } else {
+            *out++ = '~';
+        }
+        out = std::copy(EOL.begin(), EOL.end(), out);
+    }
+    text.resize(static_cast<std::size_t>(out - begin));
+#else
+    (void)layout;
+#endif
+    return page;
+}
+
+void Pager::store_page(Page page) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    for (const Page& cached : cache_) {
+        if (cached.top == page.top && cached.generation == page.generation) return;
+    }
+    page.last_use = ++use_clock_;
+    if (cache_.size() < PAGER_CACHE_PAGES) {
+        cache_.push_back(std::move(page));
+        return;
+    }
+    auto oldest = std::min_element(cache_.begin(), cache_.end(),
+                                   [](const Page& a, const Page& b) { return a.last_use < b.last_use; });
+    *oldest = std::move(page);
+}
+
+Pager::Page Pager::fetch_page(std::uint64_t top) {
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        for (Page& page : cache_) {
+            if (page.top == top && page.generation == layout_.generation) {
+                page.last_use = ++use_clock_;
+                return page;
+            }
+        }
+    }
+    Page page = render_page(top, layout_);
+    // A failed read is tried again on the next draw
+    if (page.error == 0) store_page(page);
+    return page;
+}
+
+void Pager::prefetch_page(std::uint64_t top, Layout layout, std::uint64_t round) {
+    // Skip the screens next to one the user has already left
+    if (round != prefetch_round_.load(std::memory_order_relaxed)) return;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        for (const Page& page : cache_) {
+            if (page.top == top && page.generation == layout.generation) return;
+        }
+    }
+    Page page = render_page(top, layout);
+    if (page.error == 0) store_page(std::move(page));
+}
+
+void Pager::update_size() {
+#if !defined(_WIN32) && !defined(_WIN64)
+    winsize size {};
+    std::size_t rows = 24;
+    columns_ = 80;
+    if (::ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row != 0) {
+        rows = size.ws_row;
+        columns_ = size.ws_col;
+    }
+    // The last row holds the status line
+    layout_.rows = std::max<std::size_t>(1, rows - 1);
+    ++layout_.generation;
+    top_ = std::min(top_, last_top());
+#endif
+}
+
+void Pager::draw() {
+#if !defined(_WIN32) && !defined(_WIN64)
+    const auto format_offset = [this](std::uint64_t offset) {
+        if (options_.offset_format == Options::OffsetFormat::Dec) return std::to_string(offset);
+        return "0x" + to_hex_uint(offset, options_.offset_width, options_.uppercase);
+    };
+
+    const Page page = fetch_page(top_);
+    if (page.error != 0) {
+        message_ = "Error reading at " + format_offset(page.error_offset) + ": " + std::strerror(page.error);
+    }
+    std::string screen = "\x1b[H";
+    screen += page.text;
+
+    const std::uint64_t span = end_ - options_.start;
+    const std::uint64_t seen = std::min(span, top_ - options_.start + page_bytes());
+    std::string status = " ";
+    status += format_offset(top_);
+    status += " / ";
+    status += format_offset(end_);
+    status += "  ";
+    status += std::to_string(span == 0 ? 100 : seen * 100 / span);
+    status += "%  ";
+    status += message_.empty() ? "j/k line  space/b screen  g goto  / hex  s text  n next  q quit" : message_;
+    status.resize(std::max(columns_, std::size_t{1}) - 1, ' ');
+    screen += "\x1b[7m";
+    screen += status;
+    screen += "\x1b[0m";
+    write_all(screen);
+#endif
+}
+
+bool Pager::prompt(const std::string& label, std::string& line) {
+#if !defined(_WIN32) && !defined(_WIN64)
+    line.clear();
+    write_all("\x1b[?25h");
+    for (;;) {
+        const std::string row = std::to_string(layout_.rows + 1);
+        write_all("\x1b[" + row + ";1H\x1b[0m\x1b[K" + label + line);
+
+        char c;
+        const Key key = read_key(c);
+        if (resized) {
+            resized = 0;
+            update_size();
+            draw();
+            continue;
+        }
+        if (key == Key::Enter || key == Key::Escape) {
+            write_all("\x1b[?25l");
+            return key == Key::Enter;
+        }
+        if (key == Key::Backspace && !line.empty()) line.pop_back();
+        if (key == Key::Char && static_cast<unsigned char>(c) >= 0x20) line += c;
+    }
+#else
+    (void)label;
+    (void)line;
+    return false;
+#endif
+}
+
+void Pager::search_next() {
+#if !defined(_WIN32) && !defined(_WIN64)
+    const std::size_t size = pattern_.value.size();
+    if (size == 0) {
+        message_ = "No search pattern (/ hex, s text)";
+        return;
+    }
+
+    // Chunks overlap by one byte less than the pattern, so no match is cut
+    std::vector<std::byte> buffer(PAGER_SEARCH_CHUNK_SIZE + size - 1);
+    const auto* base = reinterpret_cast<const unsigned char*>(buffer.data());
+    // Continue after the highlighted match while it is on the screen
+    const bool shown = layout_.match_end > layout_.match_begin && layout_.match_begin >= top_ &&
+                       layout_.match_begin < top_ + page_bytes();
+    std::uint64_t position = shown ? layout_.match_begin + 1 : top_;
+    while (position + size <= end_) {
+        write_all("\x1b[" + std::to_string(layout_.rows + 1) + ";1H\x1b[7m Searching at 0x" +
+                  to_hex_uint(position, options_.offset_width, options_.uppercase) + " (Esc cancels)\x1b[0m\x1b[K");
+        int error = 0;
+        const std::size_t got = read_at(fd_, buffer.data(),
+                                        static_cast<std::size_t>(std::min<std::uint64_t>(buffer.size(), end_ - position)),
+                                        position, error);
+        if (error != 0) {
+            message_ = "Error reading at 0x" + to_hex_uint(position + got, options_.offset_width, options_.uppercase) +
+                       ": " + std::strerror(error);
+            return;
+        }
+        if (got < size) break;
+
+        const std::size_t count = got - size + 1;
+        for (std::size_t at = 0; at < count;) {
+            const std::size_t hit = kernels_.find_pair(base + at + first_, count - at, pattern_.value[first_],
+                                                       pattern_.value[last_], last_ - first_);
+            if (hit == count - at) break;
+            const std::size_t candidate = at + hit;
+            bool found = true;
+            for (std::size_t j = size; j-- > 0;) {
+                if ((base[candidate + j] & pattern_.mask[j]) != pattern_.value[j]) {
+                    found = false;
+                    break;
+                }
+            }
+            if (found) {
+                const std::uint64_t match = position + candidate;
+                layout_.match_begin = match;
+                layout_.match_end = match + size;
+                ++layout_.generation;
+                // Keep the screen when the whole match is already on it
+                if (match < top_ || match + size > top_ + page_bytes()) top_ = std::min(line_of(match), last_top());
+                return;
+            }
+            at = candidate + 1;
+        }
+        position += count;
+
+        char c;
+        if (read_key(c, 0) == Key::Escape) {
+            message_ = "Search cancelled";
+            return;
+        }
+    }
+    message_ = "Pattern not found";
+#endif
+}
+
+void Pager::go_to(const std::string& where) {
+    try {
+        std::uint64_t offset;
+        if (!where.empty() && where.back() == '%') {
+            const std::uint64_t percent = std::min<std::uint64_t>(100, parse_uint64(where.substr(0, where.size() - 1)));
+            offset = options_.start + (end_ - options_.start) / 100 * percent +
+                     (end_ - options_.start) % 100 * percent / 100;
+        } else {
+            offset = parse_uint64(where);
+            if (offset < options_.start || offset >= end_) {
+                message_ = "Offset outside the input";
+                return;
+            }
+        }
+        top_ = std::min(line_of(offset), last_top());
+    } catch (const std::exception&) {
+        message_ = "Invalid offset: " + where;
+    }
+}
+
+int Pager::run() {
+#if defined(_WIN32) || defined(_WIN64)
+    std::cerr << "Error: --interactive is not supported on this platform\n";
+    return 1;
+#else
+    if (options_.filename == "-") {
+        std::cerr << "Error: --interactive needs a file, not stdin\n";
+        return 1;
+    }
+    if (!::isatty(STDIN_FILENO) || !::isatty(STDOUT_FILENO)) {
+        std::cerr << "Error: --interactive needs a terminal\n";
+        return 1;
+    }
+    fd_ = ::open(options_.filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        std::cerr << "Error: failed to open file '" << options_.filename << "'\n";
+        return 1;
+    }
+    struct stat st {};
+    if (::fstat(fd_, &st) != 0 || !(S_ISREG(st.st_mode) || S_ISBLK(st.st_mode))) {
+        std::cerr << "Error: --interactive needs a regular file or block device\n";
+        ::close(fd_);
+        return 1;
+    }
+    end_ = range_end(seekable_size(fd_), options_.start, options_.length);
+    top_ = options_.start;
+
+    {
+        TerminalMode terminal;
+        if (!terminal.enter()) {
+            std::cerr << "Error: failed to set up the terminal\n";
+            ::close(fd_);
+            return 1;
+        }
+        update_size();
+        if (!pattern_.value.empty()) search_next();
+
+        // Declared last so prefetches finish before the terminal is restored
+        ThreadPool prefetcher(1);
+        std::string line;
+        for (bool quit = false; !quit;) {
+            draw();
+            message_.clear();
+
+            // The screens next to this one are rendered while the user reads it;
+            // prefetches still queued for an earlier screen are dropped
+            const Layout layout = layout_;
+            const std::uint64_t page = page_bytes();
+            const std::uint64_t round = prefetch_round_.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (top_ < last_top()) {
+                const std::uint64_t below = std::min(top_ + page, last_top());
+                prefetcher.submit([this, below, layout, round] { prefetch_page(below, layout, round); });
+            }
+            if (top_ > options_.start) {
+                const std::uint64_t above = top_ - std::min(top_ - options_.start, page);
+                prefetcher.submit([this, above, layout, round] { prefetch_page(above, layout, round); });
+            }
+
+            char c = 0;
+            const Key key = read_key(c);
+            if (resized) {
+                resized = 0;
+                update_size();
+                continue;
+            }
+
+            const std::size_t BPL = options_.bytes_per_line;
+            switch (key) {
+            case Key::Down:
+            case Key::Enter:
+                top_ = std::min(top_ + BPL, last_top());
+                break;
+            case Key::Up:
+                top_ -= std::min<std::uint64_t>(top_ - options_.start, BPL);
+                break;
+            case Key::PageDown:
+                top_ = std::min(top_ + page, last_top());
+                break;
+            case Key::PageUp:
+                top_ -= std::min(top_ - options_.start, page);
+                break;
+            case Key::Home:
+                top_ = options_.start;
+                break;
+            case Key::End:
+                top_ = last_top();
+                break;
+            case Key::Char:
+                switch (c) {
+                case 'j': top_ = std::min(top_ + BPL, last_top()); break;
+                case 'k': top_ -= std::min<std::uint64_t>(top_ - options_.start, BPL); break;
+                case ' ': case 'f': top_ = std::min(top_ + page, last_top()); break;
+                case 'b': top_ -= std::min(top_ - options_.start, page); break;
+                case '<': top_ = options_.start; break;
+                case '>': case 'G': top_ = last_top(); break;
+                case 'g':
+                    if (prompt("Go to offset or percentage: ", line)) go_to(line);
+                    break;
+                case '/':
+                case 's':
+                    if (prompt(c == '/' ? "Hex pattern: " : "Text pattern: ", line) && !line.empty()) {
+                        try {
+                            set_pattern(c == '/' ? SearchPattern::from_hex(line) : SearchPattern::from_text(line));
+                            layout_.match_begin = layout_.match_end = 0;
+                            ++layout_.generation;
+                            search_next();
+                        } catch (const std::invalid_argument& e) {
+                            message_ = e.what();
+                        }
+                    }
+                    break;
+                case 'n': search_next(); break;
+                case 'q': case 0x03: quit = true; break;
+                default: break;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    ::close(fd_);
+    return 0;
+#endif
+}
+
+} // namespace hexview
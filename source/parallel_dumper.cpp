@@ -0,0 +1,269 @@
+#include "parallel_dumper.hpp"
+#include "config.hpp"
+#include "line_squeezer.hpp"
+#include "ordered_chunks.hpp"
+#include "thread_pool.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace hexview {
+
+ParallelDumper::ParallelDumper(const Options& options, const Formatter& formatter, OutputSink& sink)
+    : options_(options), formatter_(formatter), sink_(sink) {}
+
+ParallelDumper::~ParallelDumper() {
+#if !defined(_WIN32) && !defined(_WIN64)
+    if (fd_ >= 0) ::close(fd_);
+#endif
+}
+
+bool ParallelDumper::open(const std::string& path) {
+#if defined(_WIN32) || defined(_WIN64)
+    (void)path;
+    return false;
+#else
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) return false;
+
+    // Only inputs with a known size can be split into chunks up front
+    const std::uint64_t size = seekable_size(fd_);
+    if (size == 0) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    const std::uint64_t start = options_.start;
+    end_ = range_end(size, start, options_.length);
+
+#  if defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(fd_, static_cast<off_t>(start), 0, POSIX_FADV_SEQUENTIAL);
+#  endif
+    return true;
+#endif
+}
+
+void ParallelDumper::render_chunk(ChunkSlot& slot) const {
+    if (slot.input.size() < slot.length) slot.input.resize(slot.length);
+    const std::size_t got = read_at(fd_, slot.input.data(), slot.length, slot.offset, slot.error);
+    slot.length = got;
+
+    const std::size_t BPL = options_.bytes_per_line;
+    const std::size_t lines = (got + BPL - 1) / BPL;
+    const std::size_t capacity = lines * formatter_.max_line_size();
+    if (slot.output.size() < capacity) slot.output.resize(capacity);
+
+    std::span<const std::byte> data(slot.input.data(), got);
+    char* out = slot.output.data();
+    if (!options_.squeeze) {
+        for (std::size_t pos = 0; pos < got; pos += BPL) {
+            out = formatter_.render_line(data.subspan(pos, std::min(BPL, got - pos)), slot.offset + pos, out);
+        }
+        slot.output_size = static_cast<std::size_t>(out - slot.output.data());
+        return;
+    }
+
+    // Squeezing depends on the two lines in front of the chunk
+    LineSqueezer squeezer(formatter_, BPL);
+    const std::size_t context = static_cast<std::size_t>(std::min<std::uint64_t>(2 * BPL, slot.offset - options_.start));
+    std::vector<std::byte> before(context);
+    int error = 0;
+    if (context != 0 && read_at(fd_, before.data(), context, slot.offset - context, error) == context) {
+        std::span<const std::byte> previous(before);
+        // The hole marker in front counts as a printed line, as in a sequential pass
+        if (context == 2 * BPL && !slot.after_hole) {
+            squeezer.prime(previous.first(BPL), previous.last(BPL));
+        } else {
+            squeezer.prime({}, previous.last(BPL));
+        }
+    }
+
+    for (std::size_t pos = 0; pos < got; pos += BPL) {
+        out = squeezer.render(data.subspan(pos, std::min(BPL, got - pos)), slot.offset + pos, out);
+    }
+    if (slot.offset + got >= end_) out = squeezer.finish(out);
+    slot.output_size = static_cast<std::size_t>(out - slot.output.data());
+}
+
+int ParallelDumper::run() {
+    const std::size_t BPL = options_.bytes_per_line;
+    const std::uint64_t start = options_.start;
+    if (end_ <= start) return 0;
+
+    const std::size_t chunk_size = std::max(BPL, PARALLEL_CHUNK_SIZE - PARALLEL_CHUNK_SIZE % BPL);
+    OrderedChunks<ChunkSlot> chunks(options_.threads);
+
+    // Lines inside holes of a sparse file become a marker instead of a chunk
+    std::uint64_t next = start;
+    ByteRange hole{end_, end_};
+    if (options_.squeeze) hole = find_hole_lines(fd_, start, end_, BPL);
+    bool after_hole = false;
+
+    auto fill = [&](ChunkSlot& slot) {
+        if (next >= end_) return false;
+        slot.error = 0;
+        slot.offset = next;
+
+        if (next == hole.begin) {
+            slot.end = hole.end;
+            slot.length = 0;
+            slot.hole = true;
+            next = hole.end;
+            hole = find_hole_lines(fd_, next, end_, BPL);
+
+            // Rendered right here: the marker needs no input
+            LineSqueezer squeezer(formatter_, BPL);
+            if (slot.output.size() < formatter_.max_line_size() * 2) slot.output.resize(formatter_.max_line_size() * 2);
+            char* out = squeezer.skip_hole(slot.offset, slot.end, slot.output.data());
+            if (next == end_) out = squeezer.finish(out);
+            slot.output_size = static_cast<std::size_t>(out - slot.output.data());
+            after_hole = true;
+            return true;
+        }
+
+        slot.end = std::min(next + chunk_size, hole.begin);
+        slot.length = static_cast<std::size_t>(slot.end - next);
+        slot.hole = false;
+        slot.after_hole = after_hole;
+        after_hole = false;
+        next = slot.end;
+        return true;
+    };
+
+    int rc = 0;
+    chunks.run(fill,
+               [this](ChunkSlot& slot) {
+                   if (!slot.hole) render_chunk(slot);
+               },
+               [&](const ChunkSlot& slot) {
+                   sink_.write(std::string_view(slot.output.data(), slot.output_size));
+                   if (slot.error != 0) {
+                       std::cerr << "Error: failed to read '" << options_.filename << "' at offset "
+                                 << slot.offset + slot.length << ": " << std::strerror(slot.error) << "\n";
+                       rc = 1;
+                       return false;
+                   }
+                   return (slot.hole || slot.offset + slot.length == slot.end) && sink_.good();
+               });
+    return rc;
+}
+
+int ParallelDumper::run_positional(int out_fd) {
+#if defined(_WIN32) || defined(_WIN64)
+    (void)out_fd;
+    return run();
+#else
+    const std::size_t BPL = options_.bytes_per_line;
+    const std::uint64_t start = options_.start;
+    const std::uint64_t range = end_ > start ? end_ - start : 0;
+    const std::uint64_t full_lines = range / BPL;
+    const std::uint64_t body_end = start + full_lines * BPL;
+
+    // The partial last line is the only one whose size needs its bytes
+    std::vector<std::byte> tail_input(BPL);
+    std::vector<char> tail(formatter_.max_line_size());
+    std::size_t tail_size = 0;
+    if (body_end < end_) {
+        int error = 0;
+        const std::size_t want = static_cast<std::size_t>(end_ - body_end);
+        const std::size_t got = read_at(fd_, tail_input.data(), want, body_end, error);
+        if (got != want) {
+            std::cerr << "Error: failed to read '" << options_.filename << "' at offset "
+                      << body_end + got << ": " << std::strerror(error != 0 ? error : EIO) << "\n";
+            return 1;
+        }
+        char* out = formatter_.render_line(std::span<const std::byte>(tail_input.data(), got), body_end, tail.data());
+        tail_size = static_cast<std::size_t>(out - tail.data());
+    }
+
+    const std::uint64_t body_size = formatter_.full_lines_size(start, full_lines);
+    if (::ftruncate(out_fd, static_cast<off_t>(body_size + tail_size)) != 0) {
+        std::cerr << "Error: failed to size output file '" << options_.output << "': "
+                  << std::strerror(errno) << "\n";
+        return 1;
+    }
+
+    const std::uint64_t chunk_lines = std::max<std::size_t>(1, PARALLEL_CHUNK_SIZE / BPL);
+    std::atomic<int> failure{0};
+    std::atomic<std::uint64_t> failed_offset{0};
+    {
+        ThreadPool pool(options_.threads);
+        std::uint64_t position = 0;
+        for (std::uint64_t line = 0; line < full_lines; line += chunk_lines) {
+            const std::uint64_t lines = std::min(chunk_lines, full_lines - line);
+            const std::uint64_t offset = start + line * BPL;
+            const std::uint64_t size = formatter_.full_lines_size(offset, lines);
+
+            pool.submit([this, out_fd, offset, lines, position, size, &failure, &failed_offset] {
+                if (failure.load(std::memory_order_relaxed) != 0) return;
+
+                // Buffers are reused by every chunk a worker renders
+                thread_local ChunkSlot scratch;
+                scratch.offset = offset;
+                scratch.length = static_cast<std::size_t>(lines * options_.bytes_per_line);
+                scratch.error = 0;
+                const std::size_t wanted = scratch.length;
+                render_chunk(scratch);
+
+                int error = scratch.error;
+                std::uint64_t at = offset + scratch.length;
+                if (error == 0 && scratch.length != wanted) error = EIO;
+                if (error == 0 && scratch.output_size != size) error = EIO;
+                for (std::size_t done = 0; error == 0 && done < scratch.output_size;) {
+                    ssize_t n = ::pwrite(out_fd, scratch.output.data() + done, scratch.output_size - done,
+                                         static_cast<off_t>(position + done));
+                    if (n < 0) {
+                        if (errno == EINTR) continue;
+                        error = -errno; // negative: a write error
+                        break;
+                    }
+                    done += static_cast<std::size_t>(n);
+                }
+
+                int expected = 0;
+                if (error != 0 && failure.compare_exchange_strong(expected, error)) {
+                    failed_offset.store(at);
+                }
+            });
+            position += size;
+        }
+    }
+
+    const int error = failure.load();
+    if (error > 0) {
+        std::cerr << "Error: failed to read '" << options_.filename << "' at offset "
+                  << failed_offset.load() << ": " << std::strerror(error) << "\n";
+        return 1;
+    }
+    if (error < 0) {
+        std::cerr << "Error: failed to write output file '" << options_.output << "': "
+                  << std::strerror(-error) << "\n";
+        return 1;
+    }
+
+    for (std::size_t done = 0; done < tail_size;) {
+        ssize_t n = ::pwrite(out_fd, tail.data() + done, tail_size - done,
+                             static_cast<off_t>(body_size + done));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Error: failed to write output file '" << options_.output << "': "
+                      << std::strerror(errno) << "\n";
+            return 1;
+        }
+        done += static_cast<std::size_t>(n);
+    }
+    return 0;
+#endif
+}
+
+} // namespace hexview
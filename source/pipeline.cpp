@@ -0,0 +1,212 @@
+#include "pipeline.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#  include <unistd.h>
+#endif
+
+namespace hexview {
+
+Pipeline::Pipeline(const Options& options, const Formatter& formatter, OutputSink& sink)
+    : options_(options),
+      formatter_(formatter),
+      sink_(sink),
+      block_size_(std::max(PIPELINE_BLOCK_SIZE, options.bytes_per_line)),
+      output_size_((block_size_ / options.bytes_per_line + 2) * formatter.max_line_size()),
+      inputs_(PIPELINE_BUFFERS * block_size_),
+      outputs_(PIPELINE_BUFFERS * output_size_),
+      pending_(options.bytes_per_line),
+      squeezer_(formatter, options.bytes_per_line) {
+    for (std::uint32_t i = 0; i < PIPELINE_BUFFERS; ++i) {
+        Block block;
+        block.index = i;
+        free_inputs_.push(block);
+        free_outputs_.push(block);
+    }
+}
+
+void Pipeline::read_stage(int fd) {
+    Block block = free_inputs_.pop();
+    std::byte* data = inputs_.data() + block.index * block_size_;
+    int error = 0;
+
+    const bool skipped = skip_to_start(fd, options_.start, options_.filename == "-",
+                                       std::span<std::byte>(data, block_size_));
+
+    std::uint64_t remaining = options_.length; // 0 => unlimited
+    const bool limited = options_.length != 0;
+    bool done = !skipped;
+
+    // Holes of a sparse file are passed on instead of read
+    std::uint64_t position = options_.start;
+    const std::uint64_t size = options_.squeeze && options_.filename != "-" ? seekable_size(fd) : 0;
+    const std::uint64_t stop = range_end(size, options_.start, options_.length);
+    const ByteRange no_hole{UINT64_MAX, UINT64_MAX};
+    auto seek = [fd](std::uint64_t offset) {
+#if defined(_WIN32) || defined(_WIN64)
+        (void)fd;
+        (void)offset;
+        return false;
+#else
+        return ::lseek(fd, static_cast<off_t>(offset), SEEK_SET) >= 0;
+#endif
+    };
+    auto find_hole = [&] {
+        if (size == 0) return no_hole;
+        const ByteRange found = find_hole_lines(fd, position, stop, options_.bytes_per_line);
+        // Looking for holes moves the file offset
+        if (!seek(position)) return no_hole;
+        return found.begin < stop ? found : no_hole;
+    };
+    ByteRange hole = done ? no_hole : find_hole();
+
+    while (!done) {
+        if (position == hole.begin) {
+            if (!seek(hole.end)) {
+                error = errno;
+                break;
+            }
+            Block skipped_hole;
+            skipped_hole.hole_end = hole.end;
+            filled_.push(skipped_hole);
+            if (limited) remaining -= hole.end - position;
+            position = hole.end;
+            done = (limited && remaining == 0) || position == stop;
+            hole = find_hole();
+            continue;
+        }
+
+        std::size_t want = block_size_;
+        if (limited && remaining < want) want = static_cast<std::size_t>(remaining);
+        if (hole.begin - position < want) want = static_cast<std::size_t>(hole.begin - position);
+
+        // Fill the block completely so short pipe reads do not fragment it
+        const std::size_t got = read_full(fd, data, want, error);
+        if (limited) remaining -= got;
+        position += got;
+        done = got < want || (limited && remaining == 0) || write_failed_.load(std::memory_order_relaxed);
+
+        if (got != 0) {
+            block.size = got;
+            filled_.push(block);
+            if (!done) {
+                block = free_inputs_.pop();
+                data = inputs_.data() + block.index * block_size_;
+            }
+        }
+    }
+
+    Block end;
+    end.last = true;
+    end.error = error;
+    filled_.push(end);
+}
+
+void Pipeline::write_stage() {
+    for (;;) {
+        Block block = rendered_.pop();
+        if (block.last) return;
+        if (!write_failed_.load(std::memory_order_relaxed)) {
+            sink_.write(std::string_view(outputs_.data() + block.index * output_size_, block.size));
+            if (!sink_.good()) write_failed_.store(true, std::memory_order_relaxed);
+        }
+        free_outputs_.push(block);
+    }
+}
+
+char* Pipeline::render_line(std::span<const std::byte> line, std::uint64_t offset, char* out) {
+    return options_.squeeze ? squeezer_.render(line, offset, out) : formatter_.render_line(line, offset, out);
+}
+
+char* Pipeline::render_block(std::span<const std::byte> data, std::uint64_t offset, std::size_t& pending, char* out) {
+    const std::size_t BPL = options_.bytes_per_line;
+    std::size_t pos = 0;
+
+    if (pending != 0) {
+        pos = std::min(BPL - pending, data.size());
+        std::memcpy(pending_.data() + pending, data.data(), pos);
+        pending += pos;
+        if (pending < BPL) return out;
+        out = render_line(pending_, offset, out);
+        offset += BPL;
+        pending = 0;
+    }
+
+    const std::size_t whole = (data.size() - pos) - (data.size() - pos) % BPL;
+    for (std::size_t end = pos + whole; pos < end; pos += BPL) {
+        out = render_line(data.subspan(pos, BPL), offset, out);
+        offset += BPL;
+    }
+
+    pending = data.size() - pos;
+    if (pending != 0) std::memcpy(pending_.data(), data.data() + pos, pending);
+    return out;
+}
+
+int Pipeline::run(int fd) {
+    std::thread reader([this, fd] { read_stage(fd); });
+    std::thread writer([this] { write_stage(); });
+
+    // Formatter stage runs on the calling thread
+    std::uint64_t offset = options_.start;    // offset of the next input byte
+    std::size_t pending = 0;
+    int error = 0;
+    for (;;) {
+        Block input = filled_.pop();
+        if (input.last) {
+            error = input.error;
+            break;
+        }
+
+        Block output = free_outputs_.pop();
+        char* begin = outputs_.data() + output.index * output_size_;
+        if (input.hole_end != 0) {
+            // Holes start on a line boundary, so no partial line is pending
+            char* end = squeezer_.skip_hole(offset, input.hole_end, begin);
+            offset = input.hole_end;
+            output.size = static_cast<std::size_t>(end - begin);
+            rendered_.push(output);
+            continue;
+        }
+        std::span<const std::byte> data(inputs_.data() + input.index * block_size_, input.size);
+        char* end = render_block(data, offset - pending, pending, begin);
+        offset += input.size;
+        free_inputs_.push(input);
+
+        output.size = static_cast<std::size_t>(end - begin);
+        rendered_.push(output);
+    }
+
+    // Final partial line, or the last line of a run the input ended in
+    {
+        Block output = free_outputs_.pop();
+        char* begin = outputs_.data() + output.index * output_size_;
+        char* end = begin;
+        if (pending != 0) {
+            end = render_line(std::span<const std::byte>(pending_.data(), pending), offset - pending, end);
+        }
+        if (options_.squeeze) end = squeezer_.finish(end);
+        output.size = static_cast<std::size_t>(end - begin);
+        rendered_.push(output);
+    }
+
+    Block end;
+    end.last = true;
+    rendered_.push(end);
+    writer.join();
+    reader.join();
+
+    if (error != 0) {
+        std::cerr << "Error: failed to read input at offset " << offset << ": " << std::strerror(error) << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace hexview
@@ -0,0 +1,366 @@
+#include "reverser.hpp"
+#include "config.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+
+#if defined(_WIN32) || defined(_WIN64)
+#  include <io.h>
+#else
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace hexview {
+
+namespace {
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+/**
+ * @brief Write a whole buffer to a stream, retrying short writes
+ * @return 0 for success, errno otherwise
+ */
+int write_all(int fd, const unsigned char* data, std::size_t size) {
+    while (size != 0) {
+#if defined(_WIN32) || defined(_WIN64)
+        int n = _write(fd, data, static_cast<unsigned int>(std::min<std::size_t>(size, 1u << 30)));
+#else
+        ssize_t n = ::write(fd, data, size);
+#endif
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return errno;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return 0;
+}
+
+} // namespace
+
+HexReverser::HexReverser(const Options& options, int out_fd)
+    : options_(options),
+      kernels_(hex_kernels()),
+      out_fd_(out_fd),
+      cells_(options.bytes_per_line),
+      gathered_(2 * options.bytes_per_line),
+      line_(options.bytes_per_line) {
+    const std::size_t BPL = options_.bytes_per_line;
+
+    // Same cell positions as the formatter: one space after every byte and
+    // one more at the end of each group
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < BPL; ++i) {
+        cells_[i] = pos;
+        pos += 2;
+        if (i != BPL - 1) pos += ((i + 1) % options_.group == 0) ? 2 : 1;
+    }
+    // A swapped ASCII column is padded to bytes_per_line characters
+    if (options_.swap_columns && !options_.hex_only) hex_column_ = BPL + 1;
+
+    pending_.reserve(REVERSE_BLOCK_SIZE);
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    // Regular files are written in place, so gaps become holes
+    struct stat st {};
+    const int flags = ::fcntl(out_fd_, F_GETFL);
+    if (::fstat(out_fd_, &st) == 0 && S_ISREG(st.st_mode) && flags != -1 && (flags & O_APPEND) == 0) {
+        const off_t position = ::lseek(out_fd_, 0, SEEK_CUR);
+        if (position != -1) {
+            positional_ = true;
+            base_ = static_cast<std::uint64_t>(position);
+        }
+    }
+#endif
+}
+
+int HexReverser::run(int in_fd) {
+    std::vector<char> buffer(REVERSE_BLOCK_SIZE);
+    std::size_t carry = 0;
+    std::uint64_t line_number = 0;
+    bool continued = false;     // the buffer starts in the middle of a long plain hex line
+    bool malformed = false;
+    int read_error = 0;
+
+    for (;;) {
+        long got = read_some(in_fd, reinterpret_cast<std::byte*>(buffer.data() + carry), buffer.size() - carry);
+        if (got < 0) {
+            read_error = errno;
+            break;
+        }
+
+        const std::size_t size = carry + static_cast<std::size_t>(got);
+        std::size_t pos = 0;
+        while (pos < size) {
+            const void* newline = std::memchr(buffer.data() + pos, '\n', size - pos);
+            if (newline == nullptr) {
+                if (got != 0) break;
+                newline = buffer.data() + size; // unterminated last line
+            }
+            const std::size_t end = static_cast<std::size_t>(static_cast<const char*>(newline) - buffer.data());
+            std::string_view line(buffer.data() + pos, end - pos);
+            ++line_number;
+            if (!(continued ? parse_plain(line) : parse_line(line))) {
+                malformed = true;
+                break;
+            }
+            continued = false;
+            pos = end + 1;
+        }
+        if (malformed || got == 0) break;
+
+        carry = size - pos;
+        if (carry == buffer.size()) {
+            // A line longer than the buffer can only be plain hex
+            std::string_view part(buffer.data(), carry);
+            if (!continued && (options_.hide_offset || part.front() == '*')) {
+                ++line_number;
+                malformed = true;
+                break;
+            }
+            if (!parse_plain(part)) {
+                ++line_number;
+                malformed = true;
+                break;
+            }
+            continued = true;
+            carry = 0;
+        } else if (carry != 0 && pos != 0) {
+            std::memmove(buffer.data(), buffer.data() + pos, carry);
+        }
+    }
+
+    flush();
+#if !defined(_WIN32) && !defined(_WIN64)
+    if (positional_) {
+        // A trailing gap still belongs to the output, and a shared stdout
+        // continues after the last byte
+        const std::uint64_t final_end = base_ + std::max(end_, position_);
+        struct stat st {};
+        if (write_error_ == 0 && ::fstat(out_fd_, &st) == 0 && static_cast<std::uint64_t>(st.st_size) < final_end &&
+            ::ftruncate(out_fd_, static_cast<off_t>(final_end)) != 0) {
+            write_error_ = errno;
+        }
+        ::lseek(out_fd_, static_cast<off_t>(final_end), SEEK_SET);
+    }
+#endif
+    if (!positional_ && position_ > end_) write_at(position_, nullptr, 0);
+
+    if (malformed) {
+        std::cerr << "Error: line " << line_number << " is not a valid dump line"
+                  << " (the layout options must match the dump)\n";
+        return 1;
+    }
+    if (read_error != 0) {
+        std::cerr << "Error: failed to read input: " << std::strerror(read_error) << "\n";
+        return 1;
+    }
+    if (write_error_ != 0) {
+        std::cerr << "Error: failed to write output: " << std::strerror(write_error_) << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+bool HexReverser::parse_line(std::string_view line) {
+    if (options_.style == Options::Style::Plain) return parse_plain(line);
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    if (line.empty()) return true;
+
+    if (line.front() == '*') {
+        constexpr std::string_view HOLE = "* hole ";
+        if (line == "*") {
+            if (options_.hide_offset && !repeat_warned_) {
+                std::cerr << "Warning: squeezed lines cannot be restored without offsets; dump with -v.\n";
+                repeat_warned_ = true;
+            }
+            repeat_ = true;
+            return true;
+        }
+        if (line.substr(0, HOLE.size()) != HOLE) return false;
+
+        // Lines inside a hole, and zero lines squeezed after it, read back as zeros
+        const std::string_view range = line.substr(HOLE.size());
+        const std::size_t dash = range.find('-');
+        std::uint64_t begin = 0;
+        std::uint64_t end = 0;
+        if (dash == std::string_view::npos || !parse_offset(range.substr(0, dash), begin) ||
+            !parse_offset(range.substr(dash + 1), end) || end < begin) {
+            return false;
+        }
+        if (repeat_) expand_repeats(begin);
+        std::fill(line_.begin(), line_.end(), 0);
+        line_size_ = line_.size();
+        line_zero_ = true;
+        repeat_ = true;
+        position_ = end;
+        return true;
+    }
+
+    if (options_.hide_offset) return parse_columns(line, position_);
+
+    // Lines that do not start with an offset are plain hex
+    const std::size_t colon = line.find(':');
+    std::uint64_t offset = 0;
+    if (colon == std::string_view::npos || !parse_offset(line.substr(0, colon), offset)) {
+        return parse_plain(line);
+    }
+    std::string_view columns = line.substr(colon + 1);
+    if (!columns.empty() && columns.front() == ' ') columns.remove_prefix(1);
+    return parse_columns(columns, offset);
+}
+
+bool HexReverser::parse_offset(std::string_view text, std::uint64_t& value) const {
+    const int base = (options_.offset_format == Options::OffsetFormat::Hex) ? 16 : 10;
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value, base);
+    return !text.empty() && ec == std::errc() && ptr == end;
+}
+
+bool HexReverser::parse_columns(std::string_view text, std::uint64_t offset) {
+    const std::size_t BPL = options_.bytes_per_line;
+    const std::string_view hex = text.size() > hex_column_ ? text.substr(hex_column_) : std::string_view();
+
+    // Missing bytes of a short last line are blank cells
+    std::size_t count = 0;
+    if (hex.size() >= cells_[BPL - 1] + 2 && hex[cells_[BPL - 1]] != ' ') {
+        count = BPL;
+    } else {
+        while (count < BPL && cells_[count] + 2 <= hex.size() && hex[cells_[count]] != ' ') ++count;
+    }
+    if (count == 0) return false;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        std::memcpy(gathered_.data() + 2 * i, hex.data() + cells_[i], 2);
+    }
+    if (repeat_) {
+        expand_repeats(offset);
+        repeat_ = false;
+    }
+    if (!kernels_.decode_hex(gathered_.data(), count, line_.data())) return false;
+
+    emit(offset, line_.data(), count);
+    line_size_ = count;
+    line_zero_ = std::all_of(line_.begin(), line_.begin() + static_cast<std::ptrdiff_t>(count),
+                             [](unsigned char b) { return b == 0; });
+    position_ = offset + count;
+    return true;
+}
+
+bool HexReverser::parse_plain(std::string_view text) {
+    std::size_t i = 0;
+
+    // Lines without whitespace decode in one kernel call
+    if (nibble_ < 0 && text.size() >= 2) {
+        const std::size_t pairs = text.size() / 2;
+        if (plain_.size() < pairs) plain_.resize(pairs);
+        if (kernels_.decode_hex(text.data(), pairs, plain_.data())) {
+            emit(position_, plain_.data(), pairs);
+            position_ += pairs;
+            i = 2 * pairs;
+        }
+    }
+
+    for (; i < text.size(); ++i) {
+        if (is_space(text[i])) continue;
+        const int value = hex_value(text[i]);
+        if (value < 0) return false;
+        if (nibble_ < 0) {
+            nibble_ = value;
+            continue;
+        }
+        const unsigned char byte = static_cast<unsigned char>((nibble_ << 4) | value);
+        emit(position_, &byte, 1);
+        ++position_;
+        nibble_ = -1;
+    }
+    return true;
+}
+
+void HexReverser::expand_repeats(std::uint64_t until) {
+    // Only full lines are ever squeezed
+    if (line_size_ != options_.bytes_per_line || until <= position_) return;
+
+    const std::uint64_t lines = (until - position_) / line_size_;
+    if (line_zero_ && positional_) {
+        position_ += lines * line_size_; // left as a hole
+        return;
+    }
+    for (std::uint64_t i = 0; i < lines; ++i) {
+        emit(position_, line_.data(), line_size_);
+        position_ += line_size_;
+    }
+}
+
+void HexReverser::emit(std::uint64_t offset, const unsigned char* data, std::size_t size) {
+    if (offset != pending_offset_ + pending_.size()) {
+        flush();
+        pending_offset_ = offset;
+    }
+    while (size != 0) {
+        const std::size_t room = pending_.capacity() - pending_.size();
+        const std::size_t n = std::min(size, room);
+        pending_.insert(pending_.end(), data, data + n);
+        data += n;
+        size -= n;
+        if (pending_.size() == pending_.capacity()) flush();
+    }
+}
+
+void HexReverser::flush() {
+    if (pending_.empty()) return;
+    write_at(pending_offset_, pending_.data(), pending_.size());
+    pending_offset_ += pending_.size();
+    pending_.clear();
+}
+
+void HexReverser::write_at(std::uint64_t offset, const unsigned char* data, std::size_t size) {
+    if (write_error_ != 0) return;
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    if (positional_) {
+        for (std::size_t done = 0; done < size;) {
+            ssize_t n = ::pwrite(out_fd_, data + done, size - done, static_cast<off_t>(base_ + offset + done));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                write_error_ = errno;
+                return;
+            }
+            done += static_cast<std::size_t>(n);
+        }
+        end_ = std::max(end_, offset + size);
+        return;
+    }
+#endif
+
+    // Streams cannot go back, and gaps are written out as zero bytes
+    if (offset < end_) {
+        write_error_ = ESPIPE;
+        return;
+    }
+    static const unsigned char zeros[4096] = {};
+    while (end_ < offset && write_error_ == 0) {
+        const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(sizeof(zeros), offset - end_));
+        write_error_ = write_all(out_fd_, zeros, n);
+        end_ += n;
+    }
+    if (write_error_ == 0) write_error_ = write_all(out_fd_, data, size);
+    end_ = offset + size;
+}
+
+} // namespace hexview
@@ -0,0 +1,310 @@
+#include "signature_scanner.hpp"
+#include "config.hpp"
+#include "finder.hpp"
+#include "ordered_chunks.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+
+namespace hexview {
+
+namespace {
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) text.remove_prefix(1);
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) text.remove_suffix(1);
+    return text;
+}
+
+} // namespace
+
+SignatureSet::SignatureSet(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) throw std::invalid_argument("failed to open signatures file '" + path + "'");
+
+    std::vector<std::vector<unsigned char>> patterns;
+    std::string line;
+    for (std::size_t number = 1; std::getline(file, line); ++number) {
+        const std::string_view text = trim(line);
+        if (text.empty() || text.front() == '#') continue;
+
+        const std::string where = "signatures file '" + path + "' line " + std::to_string(number) + ": ";
+        std::size_t name_end = 0;
+        while (name_end < text.size() && !std::isspace(static_cast<unsigned char>(text[name_end]))) ++name_end;
+        const std::string_view value = trim(text.substr(name_end));
+        if (value.empty()) throw std::invalid_argument(where + "missing pattern after the name");
+
+        SearchPattern pattern;
+        try {
+            if (value.front() == '"') {
+                if (value.size() < 2 || value.back() != '"') throw std::invalid_argument("unterminated text pattern");
+                pattern = SearchPattern::from_text(value.substr(1, value.size() - 2));
+            } else {
+                pattern = SearchPattern::from_hex(value);
+            }
+        } catch (const std::invalid_argument& e) {
+            throw std::invalid_argument(where + e.what());
+        }
+        if (pattern.value.empty()) throw std::invalid_argument(where + "empty pattern");
+        if (std::any_of(pattern.mask.begin(), pattern.mask.end(), [](unsigned char m) { return m != 0xFF; })) {
+            throw std::invalid_argument(where + "signatures cannot contain wildcards");
+        }
+
+        names_.emplace_back(text.substr(0, name_end));
+        lengths_.push_back(pattern.value.size());
+        longest_ = std::max(longest_, pattern.value.size());
+        longest_name_ = std::max(longest_name_, name_end);
+        patterns.push_back(std::move(pattern.value));
+    }
+    if (patterns.empty()) throw std::invalid_argument("no signatures in '" + path + "'");
+
+    compile(patterns);
+}
+
+void SignatureSet::compile(const std::vector<std::vector<unsigned char>>& patterns) {
+    // Class 0 holds every byte that occurs in no pattern
+    classes_.fill(0);
+    stride_ = 1;
+    for (const auto& pattern : patterns) {
+        for (unsigned char b : pattern) {
+            if (classes_[b] == 0) classes_[b] = static_cast<std::uint32_t>(stride_++);
+        }
+    }
+
+    // Trie of the patterns; -1 marks a missing edge
+    std::vector<std::int64_t> trie(stride_, -1);
+    std::vector<std::vector<std::uint32_t>> outputs(1);
+    for (std::size_t i = 0; i < patterns.size(); ++i) {
+        std::size_t state = 0;
+        for (unsigned char b : patterns[i]) {
+            const std::size_t edge = state * stride_ + classes_[b];
+            if (trie[edge] < 0) {
+                trie[edge] = static_cast<std::int64_t>(outputs.size());
+                outputs.emplace_back();
+                trie.resize(outputs.size() * stride_, -1);
+            }
+            state = static_cast<std::size_t>(trie[edge]);
+        }
+        outputs[state].push_back(static_cast<std::uint32_t>(i));
+    }
+    const std::size_t states = outputs.size();
+    if (states * stride_ >= MATCH_BIT) throw std::invalid_argument("too many signatures");
+
+    // Breadth-first: failure links point to shallower states, which are
+    // complete by the time they are followed
+    std::vector<std::size_t> next(states * stride_, 0);
+    std::vector<std::size_t> fail(states, 0);
+    std::vector<std::size_t> order;
+    order.reserve(states);
+    for (std::size_t c = 0; c < stride_; ++c) {
+        if (trie[c] < 0) continue;
+        next[c] = static_cast<std::size_t>(trie[c]);
+        order.push_back(next[c]);
+    }
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        const std::size_t state = order[i];
+        for (std::size_t c = 0; c < stride_; ++c) {
+            const std::size_t edge = state * stride_ + c;
+            const std::size_t fallback = next[fail[state] * stride_ + c];
+            if (trie[edge] < 0) {
+                next[edge] = fallback;
+                continue;
+            }
+            const auto child = static_cast<std::size_t>(trie[edge]);
+            next[edge] = child;
+            fail[child] = fallback;
+            outputs[child].insert(outputs[child].end(), outputs[fallback].begin(), outputs[fallback].end());
+            order.push_back(child);
+        }
+    }
+
+    table_.resize(states * stride_);
+    for (std::size_t edge = 0; edge < table_.size(); ++edge) {
+        const std::size_t target = next[edge];
+        table_[edge] = static_cast<std::uint32_t>(target * stride_) | (outputs[target].empty() ? 0 : MATCH_BIT);
+    }
+    output_begin_.resize(states + 1);
+    for (std::size_t state = 0; state < states; ++state) {
+        output_begin_[state] = static_cast<std::uint32_t>(outputs_.size());
+        outputs_.insert(outputs_.end(), outputs[state].begin(), outputs[state].end());
+    }
+    output_begin_[states] = static_cast<std::uint32_t>(outputs_.size());
+}
+
+void SignatureSet::scan(std::span<const std::byte> data, std::uint64_t offset, std::size_t limit,
+                        std::vector<Hit>& hits) const {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+    // Bytes past this cannot complete an occurrence that starts before limit
+    const std::size_t size = std::min(data.size(), limit + longest_ - 1);
+    const std::size_t first = hits.size();
+
+    std::uint32_t state = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        state = table_[(state & ~MATCH_BIT) + classes_[bytes[i]]];
+        if ((state & MATCH_BIT) == 0) continue;
+
+        const std::size_t row = (state & ~MATCH_BIT) / stride_;
+        for (std::uint32_t k = output_begin_[row]; k < output_begin_[row + 1]; ++k) {
+            const std::uint32_t signature = outputs_[k];
+            const std::size_t begin = i + 1 - lengths_[signature];
+            if (begin < limit) hits.push_back({ offset + begin, signature });
+        }
+    }
+
+    // Occurrences are found where they end; list them by where they start
+    std::sort(hits.begin() + static_cast<std::ptrdiff_t>(first), hits.end(), [](const Hit& a, const Hit& b) {
+        return a.offset != b.offset ? a.offset < b.offset : a.signature < b.signature;
+    });
+}
+
+SignatureScanner::SignatureScanner(const Options& options, const Formatter& formatter, OutputSink& sink)
+    : options_(options),
+      formatter_(formatter),
+      sink_(sink),
+      signatures_(options.signatures),
+      overlap_(std::max(signatures_.longest(), options.bytes_per_line) - 1) {
+    marks_.assign(signatures_.longest() + options_.bytes_per_line, 0);
+    std::fill_n(marks_.begin(), signatures_.longest(), std::uint8_t{1});
+}
+
+std::size_t SignatureScanner::max_hit_size() const {
+    return signatures_.longest_name() + 1 + formatter_.max_line_size();
+}
+
+char* SignatureScanner::render_hit(std::span<const std::byte> data, std::uint64_t offset,
+                                   const SignatureSet::Hit& hit, char* out) const {
+    const std::string& name = signatures_.name(hit.signature);
+    std::memcpy(out, name.data(), name.size());
+    out += name.size();
+    const std::size_t pad = signatures_.longest_name() + 1 - name.size();
+    std::memset(out, ' ', pad);
+    out += pad;
+
+    // The preview line starts at the hit; the signature's bytes are marked
+    const auto at = static_cast<std::size_t>(hit.offset - offset);
+    const std::span<const std::byte> preview = data.subspan(at, std::min(options_.bytes_per_line, data.size() - at));
+    const std::span<const std::uint8_t> marks(marks_.data() + signatures_.longest() - signatures_.length(hit.signature),
+                                              preview.size());
+    return formatter_.render_marked_line(preview, marks, hit.offset, out);
+}
+
+int SignatureScanner::run(int fd) {
+    bool found = false;
+    int rc = 0;
+#if !defined(_WIN32) && !defined(_WIN64)
+    // Inputs with a known size are split into chunks up front
+    const std::uint64_t size = options_.threads > 1 && options_.filename != "-" ? seekable_size(fd) : 0;
+    if (size != 0) {
+        rc = run_parallel(fd, range_end(size, options_.start, options_.length), found);
+    } else
+#endif
+    {
+        rc = run_streamed(fd, found);
+    }
+
+    if (rc != 0) return rc;
+    return found ? 0 : 1;
+}
+
+void SignatureScanner::scan_chunk(int fd, std::uint64_t end, ChunkSlot& slot) const {
+    // Read past the chunk so its last occurrences and previews are complete
+    const auto want = static_cast<std::size_t>(std::min(slot.end + overlap_, end) - slot.offset);
+    if (slot.input.size() < want) slot.input.resize(want);
+    slot.input_size = read_at(fd, slot.input.data(), want, slot.offset, slot.error);
+
+    const std::span<const std::byte> data(slot.input.data(), slot.input_size);
+    const auto limit = static_cast<std::size_t>(std::min<std::uint64_t>(slot.end - slot.offset, slot.input_size));
+    slot.hits.clear();
+    signatures_.scan(data, slot.offset, limit, slot.hits);
+
+    const std::size_t capacity = slot.hits.size() * max_hit_size();
+    if (slot.output.size() < capacity) slot.output.resize(capacity);
+    char* out = slot.output.data();
+    for (const SignatureSet::Hit& hit : slot.hits) out = render_hit(data, slot.offset, hit, out);
+    slot.output_size = static_cast<std::size_t>(out - slot.output.data());
+}
+
+int SignatureScanner::run_parallel(int fd, std::uint64_t end, bool& found) {
+    OrderedChunks<ChunkSlot> chunks(options_.threads);
+    std::uint64_t next = options_.start;
+    int rc = 0;
+
+    chunks.run(
+        [&](ChunkSlot& slot) {
+            if (next >= end) return false;
+            slot.offset = next;
+            slot.end = std::min<std::uint64_t>(next + SIGNATURE_CHUNK_SIZE, end);
+            slot.error = 0;
+            next = slot.end;
+            return true;
+        },
+        [this, fd, end](ChunkSlot& slot) { scan_chunk(fd, end, slot); },
+        [&](const ChunkSlot& slot) {
+            sink_.write(std::string_view(slot.output.data(), slot.output_size));
+            found = found || !slot.hits.empty();
+            if (slot.error != 0) {
+                std::cerr << "Error: failed to read '" << options_.filename << "' at offset "
+                          << slot.offset + slot.input_size << ": " << std::strerror(slot.error) << "\n";
+                rc = 2;
+                return false;
+            }
+            return sink_.good();
+        });
+    return rc;
+}
+
+int SignatureScanner::run_streamed(int fd, bool& found) {
+    std::vector<std::byte> buffer(overlap_ + SIGNATURE_CHUNK_SIZE);
+
+    skip_to_start(fd, options_.start, options_.filename == "-", buffer);
+
+    std::uint64_t offset = options_.start;     // offset of buffer[0]
+    std::size_t filled = 0;
+    std::uint64_t remaining = options_.length; // 0 => unlimited
+    const bool limited = options_.length != 0;
+    std::vector<SignatureSet::Hit> hits;
+    int rc = 0;
+
+    for (bool eof = false; !eof;) {
+        std::size_t want = SIGNATURE_CHUNK_SIZE;
+        if (limited && remaining < want) want = static_cast<std::size_t>(remaining);
+        long got = want == 0 ? 0 : read_some(fd, buffer.data() + filled, want);
+        if (got < 0) {
+            std::cerr << "Error: failed to read input at offset " << offset + filled << ": "
+                      << std::strerror(errno) << "\n";
+            rc = 2;
+        }
+        eof = got <= 0;
+        if (!eof) {
+            filled += static_cast<std::size_t>(got);
+            if (limited) remaining -= static_cast<std::uint64_t>(got);
+        }
+
+        // The overlap is scanned again with the next block, so only
+        // occurrences starting in front of it are reported now
+        const std::size_t limit = eof ? filled : filled - std::min(filled, overlap_);
+        if (limit == 0) continue;
+
+        const std::span<const std::byte> data(buffer.data(), filled);
+        hits.clear();
+        signatures_.scan(data, offset, limit, hits);
+        for (const SignatureSet::Hit& hit : hits) {
+            char* out = sink_.reserve(max_hit_size());
+            sink_.commit(render_hit(data, offset, hit, out));
+        }
+        found = found || !hits.empty();
+
+        filled -= limit;
+        std::memmove(buffer.data(), buffer.data() + limit, filled);
+        offset += limit;
+    }
+    return rc;
+}
+
+} // namespace hexview
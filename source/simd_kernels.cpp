@@ -0,0 +1,798 @@
+#include "simd_kernels.hpp"
+#include "render_tables.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#  define HEXVIEW_X86_KERNELS 1
+#  include <immintrin.h>
+#endif
+
+namespace hexview {
+
+HexSpread make_hex_spread(std::size_t group) {
+    HexSpread spread;
+    if (group == 0 || 16 % group != 0) return spread;
+
+    spread.group = group;
+    spread.from_low.fill(0x80);
+    spread.from_high.fill(0x80);
+    spread.fill.fill(' ');
+
+    std::size_t pos = 0;
+    auto take = [&](std::size_t pair_char) {
+        if (pair_char < 16) spread.from_low[pos] = static_cast<std::uint8_t>(pair_char);
+        else spread.from_high[pos] = static_cast<std::uint8_t>(pair_char - 16);
+        spread.fill[pos] = 0;
+        ++pos;
+    };
+
+    for (std::size_t i = 0; i < 16; ++i) {
+        take(2 * i);
+        take(2 * i + 1);
+        ++pos;                                  // separator after every byte
+        if ((i + 1) % group == 0) ++pos;        // extra separator at the end of a group
+    }
+    spread.out_size = pos;
+    return spread;
+}
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Scalar kernels
+// ---------------------------------------------------------------------------
+
+void encode_hex_scalar(const unsigned char* in, std::size_t count, char* out, bool uppercase) {
+    const char* pairs = hex_pairs(uppercase);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::memcpy(out + 2 * i, pairs + 2 * in[i], 2);
+    }
+}
+
+char* encode_hex_spread_scalar(const unsigned char* in, std::size_t blocks, char* out,
+                               bool uppercase, const HexSpread& spread) {
+    const char* pairs = hex_pairs(uppercase);
+    for (std::size_t i = 0, in_group = 1; i < blocks * 16; ++i, ++in_group) {
+        std::memcpy(out, pairs + 2 * in[i], 2);
+        out[2] = ' ';
+        out += 3;
+        if (in_group == spread.group) {
+            *out++ = ' ';
+            in_group = 0;
+        }
+    }
+    return out;
+}
+
+std::uint64_t classify_printable_scalar(const unsigned char* in, std::size_t count) {
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (in[i] >= 32 && in[i] <= 126) mask |= std::uint64_t{1} << i;
+    }
+    return mask;
+}
+
+void map_ascii_scalar(const unsigned char* in, std::size_t count, char* out, char substitute) {
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = (in[i] >= 32 && in[i] <= 126) ? static_cast<char>(in[i]) : substitute;
+    }
+}
+
+std::size_t mismatch_scalar(const unsigned char* a, const unsigned char* b, std::size_t count) {
+    // Eight bytes at a time; the lowest differing byte is the first in memory
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        std::uint64_t x = 0;
+        std::uint64_t y = 0;
+        std::memcpy(&x, a + i, 8);
+        std::memcpy(&y, b + i, 8);
+        if (x != y) {
+            if constexpr (std::endian::native == std::endian::little) {
+                return i + static_cast<std::size_t>(std::countr_zero(x ^ y)) / 8;
+            } else {
+                return i + static_cast<std::size_t>(std::countl_zero(x ^ y)) / 8;
+            }
+        }
+    }
+    for (; i < count; ++i) {
+        if (a[i] != b[i]) return i;
+    }
+    return count;
+}
+
+// Nibble value of every character, 0xFF for characters that are not hex digits
+constexpr std::array<std::uint8_t, 256> HEX_NIBBLES = [] {
+    std::array<std::uint8_t, 256> table{};
+    table.fill(0xFF);
+    for (std::size_t i = 0; i < 10; ++i) table['0' + i] = static_cast<std::uint8_t>(i);
+    for (std::size_t i = 0; i < 6; ++i) {
+        table['a' + i] = static_cast<std::uint8_t>(10 + i);
+        table['A' + i] = static_cast<std::uint8_t>(10 + i);
+    }
+    return table;
+}();
+
+bool decode_hex_scalar(const char* in, std::size_t count, unsigned char* out) {
+    unsigned invalid = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint8_t high = HEX_NIBBLES[static_cast<unsigned char>(in[2 * i])];
+        const std::uint8_t low = HEX_NIBBLES[static_cast<unsigned char>(in[2 * i + 1])];
+        invalid |= high | low;
+        out[i] = static_cast<unsigned char>((high << 4) | (low & 0x0F));
+    }
+    return (invalid & 0xF0) == 0;
+}
+
+void swap_bytes_scalar(const unsigned char* in, std::size_t count, unsigned char* out, std::size_t word) {
+    for (std::size_t i = 0; i < count; i += word) {
+        for (std::size_t j = 0; j < word; ++j) out[i + j] = in[i + word - 1 - j];
+    }
+}
+
+std::size_t find_pair_scalar(const unsigned char* in, std::size_t count, unsigned char first,
+                             unsigned char second, std::size_t gap) {
+    for (std::size_t i = 0; i < count;) {
+        const void* hit = std::memchr(in + i, first, count - i);
+        if (hit == nullptr) break;
+        i = static_cast<std::size_t>(static_cast<const unsigned char*>(hit) - in);
+        if (in[i + gap] == second) return i;
+        ++i;
+    }
+    return count;
+}
+
+// pshufb controls that reverse each 2-, 4- or 8-byte word of a 16-byte lane, indexed by log2(word)
+struct SwapControl {
+    alignas(16) std::array<std::uint8_t, 16> lane;
+};
+
+constexpr std::array<SwapControl, 4> SWAP_CONTROLS = [] {
+    std::array<SwapControl, 4> controls{};
+    for (std::size_t shift = 1; shift < 4; ++shift) {
+        const std::size_t word = std::size_t{1} << shift;
+        for (std::size_t i = 0; i < 16; ++i) {
+            controls[shift].lane[i] = static_cast<std::uint8_t>(i - i % word + (word - 1 - i % word));
+        }
+    }
+    return controls;
+}();
+
+inline const std::uint8_t* swap_control(std::size_t word) {
+    return SWAP_CONTROLS[static_cast<std::size_t>(std::countr_zero(word))].lane.data();
+}
+
+std::uint64_t count_mask(std::size_t count) {
+    return count >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << count) - 1;
+}
+
+#if defined(HEXVIEW_X86_KERNELS)
+
+// ---------------------------------------------------------------------------
+// SSE2: arithmetic nibble-to-digit conversion, no byte shuffles
+// ---------------------------------------------------------------------------
+
+__attribute__((target("sse2")))
+inline __m128i hex_digits_sse2(__m128i nibbles, __m128i alpha) {
+    __m128i above_nine = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+    __m128i digits = _mm_add_epi8(nibbles, _mm_set1_epi8('0'));
+    return _mm_add_epi8(digits, _mm_and_si128(above_nine, alpha));
+}
+
+__attribute__((target("sse2")))
+inline void hex_pairs_sse2(__m128i v, __m128i alpha, __m128i& low_pairs, __m128i& high_pairs) {
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i hi = hex_digits_sse2(_mm_and_si128(_mm_srli_epi16(v, 4), nibble), alpha);
+    __m128i lo = hex_digits_sse2(_mm_and_si128(v, nibble), alpha);
+    low_pairs = _mm_unpacklo_epi8(hi, lo);
+    high_pairs = _mm_unpackhi_epi8(hi, lo);
+}
+
+__attribute__((target("sse2")))
+inline __m128i printable_sse2(__m128i v) {
+    // (v - 32) as unsigned is below 95; biased so a signed compare works
+    __m128i biased = _mm_xor_si128(_mm_sub_epi8(v, _mm_set1_epi8(32)), _mm_set1_epi8(static_cast<char>(0x80)));
+    return _mm_cmplt_epi8(biased, _mm_set1_epi8(static_cast<char>(95 - 128)));
+}
+
+__attribute__((target("sse2")))
+void encode_hex_sse2(const unsigned char* in, std::size_t count, char* out, bool uppercase) {
+    const __m128i alpha = _mm_set1_epi8(static_cast<char>(uppercase ? 'A' - '0' - 10 : 'a' - '0' - 10));
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i low_pairs, high_pairs;
+        hex_pairs_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), alpha, low_pairs, high_pairs);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), low_pairs);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), high_pairs);
+    }
+    encode_hex_scalar(in + i, count - i, out + 2 * i, uppercase);
+}
+
+__attribute__((target("sse2")))
+char* encode_hex_spread_sse2(const unsigned char* in, std::size_t blocks, char* out,
+                             bool uppercase, const HexSpread& spread) {
+    if (spread.group != 1) {
+        return encode_hex_spread_scalar(in, blocks, out, uppercase, spread);
+    }
+    // Group 1 cells are "xx  ": interleave each pair with two spaces
+    const __m128i alpha = _mm_set1_epi8(static_cast<char>(uppercase ? 'A' - '0' - 10 : 'a' - '0' - 10));
+    const __m128i spaces = _mm_set1_epi8(' ');
+    for (std::size_t b = 0; b < blocks; ++b) {
+        __m128i low_pairs, high_pairs;
+        hex_pairs_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16 * b)), alpha, low_pairs, high_pairs);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi16(low_pairs, spaces));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm_unpackhi_epi16(low_pairs, spaces));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 32), _mm_unpacklo_epi16(high_pairs, spaces));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 48), _mm_unpackhi_epi16(high_pairs, spaces));
+        out += 64;
+    }
+    return out;
+}
+
+__attribute__((target("sse2")))
+std::uint64_t classify_printable_sse2(const unsigned char* in, std::size_t count) {
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < count; i += 16) {
+        __m128i v;
+        if (i + 16 <= count) {
+            v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        } else {
+            alignas(16) unsigned char tail[16] = {};
+            std::memcpy(tail, in + i, count - i);
+            v = _mm_load_si128(reinterpret_cast<const __m128i*>(tail));
+        }
+        auto bits = static_cast<std::uint32_t>(_mm_movemask_epi8(printable_sse2(v)));
+        mask |= std::uint64_t{bits} << i;
+    }
+    return mask & count_mask(count);
+}
+
+__attribute__((target("sse2")))
+void map_ascii_sse2(const unsigned char* in, std::size_t count, char* out, char substitute) {
+    const __m128i sub = _mm_set1_epi8(substitute);
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i keep = printable_sse2(v);
+        __m128i r = _mm_or_si128(_mm_and_si128(keep, v), _mm_andnot_si128(keep, sub));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), r);
+    }
+    map_ascii_scalar(in + i, count - i, out + i, substitute);
+}
+
+__attribute__((target("sse2")))
+std::size_t mismatch_sse2(const unsigned char* a, const unsigned char* b, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        auto equal = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+        if (equal != 0xFFFF) return i + static_cast<std::size_t>(std::countr_zero(~equal));
+    }
+    return i + mismatch_scalar(a + i, b + i, count - i);
+}
+
+__attribute__((target("sse2")))
+void swap_bytes_sse2(const unsigned char* in, std::size_t count, unsigned char* out, std::size_t word) {
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        // Swap the bytes of every 16-bit lane, then reverse 16-bit lanes within wider words
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        if (word == 4) {
+            v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+        } else if (word == 8) {
+            v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1B), 0x1B);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+    }
+    swap_bytes_scalar(in + i, count - i, out + i, word);
+}
+
+__attribute__((target("sse2")))
+std::size_t find_pair_sse2(const unsigned char* in, std::size_t count, unsigned char first,
+                           unsigned char second, std::size_t gap) {
+    const __m128i a = _mm_set1_epi8(static_cast<char>(first));
+    const __m128i b = _mm_set1_epi8(static_cast<char>(second));
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i x = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), a);
+        const __m128i y = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + gap)), b);
+        const auto hits = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(x, y)));
+        if (hits != 0) return i + static_cast<std::size_t>(std::countr_zero(hits));
+    }
+    return i + find_pair_scalar(in + i, count - i, first, second, gap);
+}
+
+// Nibble values of 16 characters; valid gets 0xFF where a character is a hex digit
+__attribute__((target("sse2")))
+inline __m128i hex_nibbles_sse2(__m128i c, __m128i& valid) {
+    // Signed compares: characters above 0x7F wrap negative or stay far out of range
+    const __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    const __m128i letter = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(digit, _mm_set1_epi8(-1)),
+                                           _mm_cmplt_epi8(digit, _mm_set1_epi8(10)));
+    const __m128i is_letter = _mm_and_si128(_mm_cmpgt_epi8(letter, _mm_set1_epi8(-1)),
+                                            _mm_cmplt_epi8(letter, _mm_set1_epi8(6)));
+    valid = _mm_or_si128(is_digit, is_letter);
+    return _mm_or_si128(_mm_and_si128(is_digit, digit),
+                        _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+__attribute__((target("sse2")))
+bool decode_hex_sse2(const char* in, std::size_t count, unsigned char* out) {
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i valid;
+        const __m128i nibbles = hex_nibbles_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i)), valid);
+        if (_mm_movemask_epi8(valid) != 0xFFFF) return false;
+        // Each 16-bit lane holds the high nibble in its low byte and the low nibble above it
+        const __m128i bytes = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4),
+                                           _mm_srli_epi16(nibbles, 8));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(bytes, bytes));
+    }
+    return decode_hex_scalar(in + 2 * i, count - i, out + i);
+}
+
+// ---------------------------------------------------------------------------
+// SSSE3: pshufb digit lookup and pshufb cell spreading
+// ---------------------------------------------------------------------------
+
+__attribute__((target("ssse3")))
+inline __m128i hex_lut_ssse3(bool uppercase) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(uppercase ? "0123456789ABCDEF" : "0123456789abcdef"));
+}
+
+__attribute__((target("ssse3")))
+inline void hex_pairs_ssse3(__m128i v, __m128i lut, __m128i& low_pairs, __m128i& high_pairs) {
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+    __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, nibble));
+    low_pairs = _mm_unpacklo_epi8(hi, lo);
+    high_pairs = _mm_unpackhi_epi8(hi, lo);
+}
+
+__attribute__((target("ssse3")))
+inline __m128i spread_chunk_ssse3(__m128i low_pairs, __m128i high_pairs, const HexSpread& spread, std::size_t chunk) {
+    __m128i from_low = _mm_load_si128(reinterpret_cast<const __m128i*>(spread.from_low.data() + 16 * chunk));
+    __m128i from_high = _mm_load_si128(reinterpret_cast<const __m128i*>(spread.from_high.data() + 16 * chunk));
+    __m128i fill = _mm_load_si128(reinterpret_cast<const __m128i*>(spread.fill.data() + 16 * chunk));
+    return _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(low_pairs, from_low),
+                                     _mm_shuffle_epi8(high_pairs, from_high)), fill);
+}
+
+__attribute__((target("ssse3")))
+void swap_bytes_ssse3(const unsigned char* in, std::size_t count, unsigned char* out, std::size_t word) {
+    const __m128i control = _mm_load_si128(
+        reinterpret_cast<const __m128i*>(swap_control(word)));
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_shuffle_epi8(v, control));
+    }
+    swap_bytes_scalar(in + i, count - i, out + i, word);
+}
+
+__attribute__((target("ssse3")))
+void encode_hex_ssse3(const unsigned char* in, std::size_t count, char* out, bool uppercase) {
+    const __m128i lut = hex_lut_ssse3(uppercase);
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i low_pairs, high_pairs;
+        hex_pairs_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), lut, low_pairs, high_pairs);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), low_pairs);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), high_pairs);
+    }
+    encode_hex_scalar(in + i, count - i, out + 2 * i, uppercase);
+}
+
+__attribute__((target("ssse3")))
+char* encode_hex_spread_ssse3(const unsigned char* in, std::size_t blocks, char* out,
+                              bool uppercase, const HexSpread& spread) {
+    const __m128i lut = hex_lut_ssse3(uppercase);
+    const std::size_t chunks = (spread.out_size + 15) / 16;
+    for (std::size_t b = 0; b < blocks; ++b) {
+        __m128i low_pairs, high_pairs;
+        hex_pairs_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16 * b)), lut, low_pairs, high_pairs);
+        for (std::size_t c = 0; c < chunks; ++c) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16 * c),
+                             spread_chunk_ssse3(low_pairs, high_pairs, spread, c));
+        }
+        out += spread.out_size;
+    }
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// AVX2: two 16-byte blocks per register, one per 128-bit lane
+// ---------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+inline void hex_pairs_avx2(__m256i v, __m256i lut, __m256i& low_pairs, __m256i& high_pairs) {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+    __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, nibble));
+    low_pairs = _mm256_unpacklo_epi8(hi, lo);   // lane k: pairs of bytes 16k .. 16k+7
+    high_pairs = _mm256_unpackhi_epi8(hi, lo);  // lane k: pairs of bytes 16k+8 .. 16k+15
+}
+
+__attribute__((target("avx2")))
+inline __m256i printable_avx2(__m256i v) {
+    __m256i biased = _mm256_xor_si256(_mm256_sub_epi8(v, _mm256_set1_epi8(32)),
+                                      _mm256_set1_epi8(static_cast<char>(0x80)));
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(95 - 128)), biased);
+}
+
+__attribute__((target("avx2")))
+void encode_hex_avx2(const unsigned char* in, std::size_t count, char* out, bool uppercase) {
+    const __m256i lut = _mm256_broadcastsi128_si256(hex_lut_ssse3(uppercase));
+    std::size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i low_pairs, high_pairs;
+        hex_pairs_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), lut, low_pairs, high_pairs);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i),
+                            _mm256_permute2x128_si256(low_pairs, high_pairs, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32),
+                            _mm256_permute2x128_si256(low_pairs, high_pairs, 0x31));
+    }
+    // The SSE tail kernels are legacy-encoded: clear the upper halves first so
+    // short calls do not pay an AVX/SSE transition stall on every row
+    _mm256_zeroupper();
+    encode_hex_ssse3(in + i, count - i, out + 2 * i, uppercase);
+}
+
+__attribute__((target("avx2")))
+char* encode_hex_spread_avx2(const unsigned char* in, std::size_t blocks, char* out,
+                             bool uppercase, const HexSpread& spread) {
+    const __m256i lut = _mm256_broadcastsi128_si256(hex_lut_ssse3(uppercase));
+    const std::size_t chunks = (spread.out_size + 15) / 16;
+    std::size_t b = 0;
+    for (; b + 2 <= blocks; b += 2) {
+        __m256i low_pairs, high_pairs;
+        hex_pairs_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 16 * b)), lut, low_pairs, high_pairs);
+
+        __m256i cells[4];
+        for (std::size_t c = 0; c < chunks; ++c) {
+            __m256i from_low = _mm256_broadcastsi128_si256(
+                _mm_load_si128(reinterpret_cast<const __m128i*>(spread.from_low.data() + 16 * c)));
+            __m256i from_high = _mm256_broadcastsi128_si256(
+                _mm_load_si128(reinterpret_cast<const __m128i*>(spread.from_high.data() + 16 * c)));
+            __m256i fill = _mm256_broadcastsi128_si256(
+                _mm_load_si128(reinterpret_cast<const __m128i*>(spread.fill.data() + 16 * c)));
+            cells[c] = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(low_pairs, from_low),
+                                                       _mm256_shuffle_epi8(high_pairs, from_high)), fill);
+        }
+        // First block completely, then the second: its cells overwrite the first block's slack
+        for (std::size_t c = 0; c < chunks; ++c) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16 * c), _mm256_castsi256_si128(cells[c]));
+        }
+        out += spread.out_size;
+        for (std::size_t c = 0; c < chunks; ++c) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16 * c), _mm256_extracti128_si256(cells[c], 1));
+        }
+        out += spread.out_size;
+    }
+    _mm256_zeroupper();
+    return encode_hex_spread_ssse3(in + 16 * b, blocks - b, out, uppercase, spread);
+}
+
+__attribute__((target("avx2")))
+std::uint64_t classify_printable_avx2(const unsigned char* in, std::size_t count) {
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < count; i += 32) {
+        __m256i v;
+        if (i + 32 <= count) {
+            v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        } else {
+            alignas(32) unsigned char tail[32] = {};
+            std::memcpy(tail, in + i, count - i);
+            v = _mm256_load_si256(reinterpret_cast<const __m256i*>(tail));
+        }
+        auto bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(printable_avx2(v)));
+        mask |= std::uint64_t{bits} << i;
+    }
+    return mask & count_mask(count);
+}
+
+__attribute__((target("avx2")))
+void map_ascii_avx2(const unsigned char* in, std::size_t count, char* out, char substitute) {
+    const __m256i sub = _mm256_set1_epi8(substitute);
+    std::size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_blendv_epi8(sub, v, printable_avx2(v)));
+    }
+    _mm256_zeroupper();
+    map_ascii_sse2(in + i, count - i, out + i, substitute);
+}
+
+__attribute__((target("avx2")))
+std::size_t mismatch_avx2(const unsigned char* a, const unsigned char* b, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        auto equal = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+        if (equal != 0xFFFFFFFFu) return i + static_cast<std::size_t>(std::countr_zero(~equal));
+    }
+    _mm256_zeroupper();
+    return i + mismatch_sse2(a + i, b + i, count - i);
+}
+
+__attribute__((target("avx2")))
+bool decode_hex_avx2(const char* in, std::size_t count, unsigned char* out) {
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i));
+        const __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+        const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+        const __m256i is_digit = _mm256_and_si256(_mm256_cmpgt_epi8(digit, _mm256_set1_epi8(-1)),
+                                                  _mm256_cmpgt_epi8(_mm256_set1_epi8(10), digit));
+        const __m256i is_letter = _mm256_and_si256(_mm256_cmpgt_epi8(letter, _mm256_set1_epi8(-1)),
+                                                   _mm256_cmpgt_epi8(_mm256_set1_epi8(6), letter));
+        if (_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)) != -1) return false;
+
+        const __m256i nibbles = _mm256_or_si256(_mm256_and_si256(is_digit, digit),
+                                                _mm256_and_si256(is_letter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+        // (high << 4) + low for every pair of characters
+        const __m256i bytes = _mm256_maddubs_epi16(nibbles, _mm256_set1_epi16(0x0110));
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(bytes, bytes), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_castsi256_si128(packed));
+    }
+    _mm256_zeroupper();
+    return decode_hex_sse2(in + 2 * i, count - i, out + i);
+}
+
+__attribute__((target("avx2")))
+void swap_bytes_avx2(const unsigned char* in, std::size_t count, unsigned char* out, std::size_t word) {
+    const __m256i control = _mm256_broadcastsi128_si256(_mm_load_si128(
+        reinterpret_cast<const __m128i*>(swap_control(word))));
+    std::size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_shuffle_epi8(v, control));
+    }
+    _mm256_zeroupper();
+    swap_bytes_ssse3(in + i, count - i, out + i, word);
+}
+
+__attribute__((target("avx2")))
+std::size_t find_pair_avx2(const unsigned char* in, std::size_t count, unsigned char first,
+                           unsigned char second, std::size_t gap) {
+    const __m256i a = _mm256_set1_epi8(static_cast<char>(first));
+    const __m256i b = _mm256_set1_epi8(static_cast<char>(second));
+    std::size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        const __m256i x = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), a);
+        const __m256i y = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + gap)), b);
+        const auto hits = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(x, y)));
+        if (hits != 0) return i + static_cast<std::size_t>(std::countr_zero(hits));
+    }
+    _mm256_zeroupper();
+    return i + find_pair_sse2(in + i, count - i, first, second, gap);
+}
+
+// ---------------------------------------------------------------------------
+// AVX-512BW: four 16-byte blocks per register, masked loads for tails
+// ---------------------------------------------------------------------------
+
+// Zero-masked forms of broadcast/extract: the unmasked ones trip GCC's
+// uninitialized-value warnings through _mm512_undefined_epi32()
+constexpr __mmask16 ALL_DWORDS = 0xFFFF;
+constexpr __mmask8 QUAD_DWORDS = 0x0F;     // the four dwords of one extracted lane
+
+__attribute__((target("avx512f,avx512bw")))
+inline void hex_pairs_avx512(__m512i v, __m512i lut, __m512i& low_pairs, __m512i& high_pairs) {
+    const __m512i nibble = _mm512_set1_epi8(0x0F);
+    __m512i hi = _mm512_shuffle_epi8(lut, _mm512_and_si512(_mm512_srli_epi16(v, 4), nibble));
+    __m512i lo = _mm512_shuffle_epi8(lut, _mm512_and_si512(v, nibble));
+    low_pairs = _mm512_unpacklo_epi8(hi, lo);
+    high_pairs = _mm512_unpackhi_epi8(hi, lo);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+inline __mmask64 printable_avx512(__m512i v) {
+    return _mm512_cmplt_epu8_mask(_mm512_sub_epi8(v, _mm512_set1_epi8(32)), _mm512_set1_epi8(95));
+}
+
+__attribute__((target("avx512f,avx512bw")))
+void encode_hex_avx512(const unsigned char* in, std::size_t count, char* out, bool uppercase) {
+    const __m512i lut = _mm512_maskz_broadcast_i32x4(ALL_DWORDS, hex_lut_ssse3(uppercase));
+    const __m512i first_half = _mm512_set_epi64(11, 10, 3, 2, 9, 8, 1, 0);
+    const __m512i second_half = _mm512_set_epi64(15, 14, 7, 6, 13, 12, 5, 4);
+    std::size_t i = 0;
+    for (; i + 64 <= count; i += 64) {
+        __m512i low_pairs, high_pairs;
+        hex_pairs_avx512(_mm512_loadu_si512(in + i), lut, low_pairs, high_pairs);
+        _mm512_storeu_si512(out + 2 * i, _mm512_permutex2var_epi64(low_pairs, first_half, high_pairs));
+        _mm512_storeu_si512(out + 2 * i + 64, _mm512_permutex2var_epi64(low_pairs, second_half, high_pairs));
+    }
+    encode_hex_avx2(in + i, count - i, out + 2 * i, uppercase);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+char* encode_hex_spread_avx512(const unsigned char* in, std::size_t blocks, char* out,
+                               bool uppercase, const HexSpread& spread) {
+    const __m512i lut = _mm512_maskz_broadcast_i32x4(ALL_DWORDS, hex_lut_ssse3(uppercase));
+    const std::size_t chunks = (spread.out_size + 15) / 16;
+    std::size_t b = 0;
+    for (; b + 4 <= blocks; b += 4) {
+        __m512i low_pairs, high_pairs;
+        hex_pairs_avx512(_mm512_loadu_si512(in + 16 * b), lut, low_pairs, high_pairs);
+
+        __m512i cells[4];
+        for (std::size_t c = 0; c < chunks; ++c) {
+            __m512i from_low = _mm512_maskz_broadcast_i32x4(ALL_DWORDS,
+                _mm_load_si128(reinterpret_cast<const __m128i*>(spread.from_low.data() + 16 * c)));
+            __m512i from_high = _mm512_maskz_broadcast_i32x4(ALL_DWORDS,
+                _mm_load_si128(reinterpret_cast<const __m128i*>(spread.from_high.data() + 16 * c)));
+            __m512i fill = _mm512_maskz_broadcast_i32x4(ALL_DWORDS,
+                _mm_load_si128(reinterpret_cast<const __m128i*>(spread.fill.data() + 16 * c)));
+            cells[c] = _mm512_or_si512(_mm512_or_si512(_mm512_shuffle_epi8(low_pairs, from_low),
+                                                       _mm512_shuffle_epi8(high_pairs, from_high)), fill);
+        }
+        // Store block by block so each block's slack is overwritten by the next one
+        for (int lane = 0; lane < 4; ++lane) {
+            for (std::size_t c = 0; c < chunks; ++c) {
+                __m128i part;
+                switch (lane) {
+                    case 0: part = _mm512_maskz_extracti32x4_epi32(QUAD_DWORDS, cells[c], 0); break;
+                    case 1: part = _mm512_maskz_extracti32x4_epi32(QUAD_DWORDS, cells[c], 1); break;
+                    case 2: part = _mm512_maskz_extracti32x4_epi32(QUAD_DWORDS, cells[c], 2); break;
+                    default: part = _mm512_maskz_extracti32x4_epi32(QUAD_DWORDS, cells[c], 3); break;
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16 * c), part);
+            }
+            out += spread.out_size;
+        }
+    }
+    return encode_hex_spread_avx2(in + 16 * b, blocks - b, out, uppercase, spread);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+std::uint64_t classify_printable_avx512(const unsigned char* in, std::size_t count) {
+    const __mmask64 valid = count_mask(count);
+    return printable_avx512(_mm512_maskz_loadu_epi8(valid, in)) & valid;
+}
+
+__attribute__((target("avx512f,avx512bw")))
+void map_ascii_avx512(const unsigned char* in, std::size_t count, char* out, char substitute) {
+    const __m512i sub = _mm512_set1_epi8(substitute);
+    for (std::size_t i = 0; i < count; i += 64) {
+        const __mmask64 valid = count_mask(count - i);
+        __m512i v = _mm512_maskz_loadu_epi8(valid, in + i);
+        _mm512_mask_storeu_epi8(out + i, valid, _mm512_mask_blend_epi8(printable_avx512(v), sub, v));
+    }
+}
+
+__attribute__((target("avx512f,avx512bw")))
+std::size_t mismatch_avx512(const unsigned char* a, const unsigned char* b, std::size_t count) {
+    for (std::size_t i = 0; i < count; i += 64) {
+        const __mmask64 valid = count_mask(count - i);
+        __m512i x = _mm512_maskz_loadu_epi8(valid, a + i);
+        __m512i y = _mm512_maskz_loadu_epi8(valid, b + i);
+        const __mmask64 differ = _mm512_cmpneq_epi8_mask(x, y);
+        if (differ != 0) return i + static_cast<std::size_t>(std::countr_zero(differ));
+    }
+    return count;
+}
+
+__attribute__((target("avx512f,avx512bw")))
+bool decode_hex_avx512(const char* in, std::size_t count, unsigned char* out) {
+    for (std::size_t i = 0; i < count; i += 32) {
+        const std::size_t n = std::min<std::size_t>(32, count - i);
+        const __mmask64 load = count_mask(2 * n);
+        const __m512i c = _mm512_maskz_loadu_epi8(load, in + 2 * i);
+        const __m512i digit = _mm512_sub_epi8(c, _mm512_set1_epi8('0'));
+        const __m512i letter = _mm512_sub_epi8(_mm512_or_si512(c, _mm512_set1_epi8(0x20)), _mm512_set1_epi8('a'));
+        const __mmask64 is_digit = _mm512_cmplt_epu8_mask(digit, _mm512_set1_epi8(10));
+        const __mmask64 is_letter = _mm512_cmplt_epu8_mask(letter, _mm512_set1_epi8(6));
+        if (((is_digit | is_letter) & load) != load) return false;
+
+        const __m512i nibbles = _mm512_mask_add_epi8(digit, is_letter, letter, _mm512_set1_epi8(10));
+        const __m512i bytes = _mm512_maddubs_epi16(nibbles, _mm512_set1_epi16(0x0110));
+        _mm512_mask_cvtepi16_storeu_epi8(out + i, static_cast<__mmask32>(count_mask(n)), bytes);
+    }
+    return true;
+}
+
+__attribute__((target("avx512f,avx512bw")))
+void swap_bytes_avx512(const unsigned char* in, std::size_t count, unsigned char* out, std::size_t word) {
+    const __m512i control = _mm512_maskz_broadcast_i32x4(ALL_DWORDS, _mm_load_si128(
+        reinterpret_cast<const __m128i*>(swap_control(word))));
+    // Words never straddle a 64-byte block, so masked tails swap whole words only
+    for (std::size_t i = 0; i < count; i += 64) {
+        const __mmask64 valid = count_mask(count - i);
+        __m512i v = _mm512_maskz_loadu_epi8(valid, in + i);
+        _mm512_mask_storeu_epi8(out + i, valid, _mm512_shuffle_epi8(v, control));
+    }
+}
+
+__attribute__((target("avx512f,avx512bw")))
+std::size_t find_pair_avx512(const unsigned char* in, std::size_t count, unsigned char first,
+                             unsigned char second, std::size_t gap) {
+    const __m512i a = _mm512_set1_epi8(static_cast<char>(first));
+    const __m512i b = _mm512_set1_epi8(static_cast<char>(second));
+    for (std::size_t i = 0; i < count; i += 64) {
+        const __mmask64 valid = count_mask(count - i);
+        const __mmask64 x = _mm512_mask_cmpeq_epi8_mask(valid, _mm512_maskz_loadu_epi8(valid, in + i), a);
+        const __mmask64 hits = _mm512_mask_cmpeq_epi8_mask(x, _mm512_maskz_loadu_epi8(x, in + i + gap), b);
+        if (hits != 0) return i + static_cast<std::size_t>(std::countr_zero(hits));
+    }
+    return count;
+}
+
+#endif // HEXVIEW_X86_KERNELS
+
+SimdLevel detect_simd_level() {
+#if defined(HEXVIEW_X86_KERNELS)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw")) return SimdLevel::AVX512BW;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("ssse3")) return SimdLevel::SSSE3;
+    if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+SimdLevel requested_simd_level() {
+    const char* env = std::getenv("HEXVIEW_SIMD");
+    if (env == nullptr) return SimdLevel::AVX512BW;
+
+    std::string_view name(env);
+    if (name == "scalar") return SimdLevel::Scalar;
+    if (name == "sse2") return SimdLevel::SSE2;
+    if (name == "ssse3") return SimdLevel::SSSE3;
+    if (name == "avx2") return SimdLevel::AVX2;
+    return SimdLevel::AVX512BW;
+}
+
+HexKernels select_kernels() {
+    SimdLevel level = std::min(detect_simd_level(), requested_simd_level());
+
+    switch (level) {
+#if defined(HEXVIEW_X86_KERNELS)
+        case SimdLevel::AVX512BW:
+            return { level, encode_hex_avx512, encode_hex_spread_avx512, classify_printable_avx512, map_ascii_avx512,
+                     mismatch_avx512, decode_hex_avx512, swap_bytes_avx512,
+                     find_pair_avx512 };
+        case SimdLevel::AVX2:
+            return { level, encode_hex_avx2, encode_hex_spread_avx2, classify_printable_avx2, map_ascii_avx2,
+                     mismatch_avx2, decode_hex_avx2, swap_bytes_avx2, find_pair_avx2 };
+        case SimdLevel::SSSE3:
+            return { level, encode_hex_ssse3, encode_hex_spread_ssse3, classify_printable_sse2, map_ascii_sse2,
+                     mismatch_sse2, decode_hex_sse2, swap_bytes_ssse3, find_pair_sse2 };
+        case SimdLevel::SSE2:
+            return { level, encode_hex_sse2, encode_hex_spread_sse2, classify_printable_sse2, map_ascii_sse2,
+                     mismatch_sse2, decode_hex_sse2, swap_bytes_sse2, find_pair_sse2 };
+#endif
+        default:
+            return { SimdLevel::Scalar, encode_hex_scalar, encode_hex_spread_scalar,
+                     classify_printable_scalar, map_ascii_scalar, mismatch_scalar, decode_hex_scalar,
+                     swap_bytes_scalar, find_pair_scalar };
+    }
+}
+
+} // namespace
+
+const HexKernels& hex_kernels() {
+    static const HexKernels selected = select_kernels();
+    return selected;
+}
+
+const char* simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar:   return "scalar";
+        case SimdLevel::SSE2:     return "sse2";
+        case SimdLevel::SSSE3:    return "ssse3";
+        case SimdLevel::AVX2:     return "avx2";
+        case SimdLevel::AVX512BW: return "avx512bw";
+    }
+    return "unknown";
+}
+
+} // namespace hexview
@@ -0,0 +1,151 @@
+#include "strings_extractor.hpp"
+#include "config.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace hexview {
+
+namespace {
+
+/**
+ * @brief Bit i set when in[i] is zero (count <= 64)
+ */
+std::uint64_t zero_mask(const unsigned char* in, std::size_t count) {
+    constexpr std::uint64_t LOW7 = 0x7F7F7F7F7F7F7F7Full;
+    constexpr std::uint64_t GATHER = 0x0102040810204080ull;  // moves bit 8k to bit 56 + k
+    std::uint64_t mask = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        std::uint64_t x;
+        std::memcpy(&x, in + i, 8);
+        // Bit 7 of every byte is set exactly when the byte is zero
+        const std::uint64_t zero = ~(((x & LOW7) + LOW7) | x | LOW7);
+        mask |= ((zero >> 7) * GATHER >> 56) << i;
+    }
+    for (; i < count; ++i) {
+        if (in[i] == 0) mask |= std::uint64_t{1} << i;
+    }
+    return mask;
+}
+
+} // namespace
+
+StringsExtractor::StringsExtractor(const Options& options, const Formatter& formatter, OutputSink& sink)
+    : options_(options),
+      formatter_(formatter),
+      sink_(sink),
+      kernels_(hex_kernels()) {}
+
+void StringsExtractor::finish(Run& run) {
+    if (run.active && run.text.size() >= options_.strings) {
+        found_.push_back({ run.start, std::move(run.text) });
+    }
+    run.text.clear();
+    run.active = false;
+}
+
+void StringsExtractor::scan(const unsigned char* data, std::size_t count, std::size_t available, std::uint64_t offset) {
+    for (std::size_t pos = 0; pos < count; pos += 64) {
+        const std::size_t size = std::min<std::size_t>(64, count - pos);
+        const unsigned char* word = data + pos;
+        const std::uint64_t base = offset + pos;
+        const std::uint64_t printable = kernels_.classify_printable(word, size);
+
+        // Walk the runs of set bits: a scan for the next start, then one for its end
+        for (std::size_t i = 0; i < size;) {
+            if (!ascii_.active) {
+                const std::uint64_t rest = printable >> i;
+                if (rest == 0) break;
+                i += static_cast<std::size_t>(std::countr_zero(rest));
+                ascii_.active = true;
+                ascii_.start = base + i;
+                continue;
+            }
+            const std::uint64_t rest = ~printable >> i;
+            const std::size_t length = rest == 0 ? size - i : std::min(size - i, static_cast<std::size_t>(std::countr_zero(rest)));
+            ascii_.text.append(reinterpret_cast<const char*>(word + i), length);
+            i += length;
+            if (i < size) finish(ascii_);
+        }
+
+        if (!options_.utf16) continue;
+
+        // A UTF-16LE character is a printable byte followed by a zero byte
+        const bool zero_after = pos + size < available && word[size] == 0;
+        const std::uint64_t zeros = (zero_mask(word, size) >> 1) | (zero_after ? std::uint64_t{1} << (size - 1) : 0);
+        for (std::uint64_t chars = printable & zeros; chars != 0; chars &= chars - 1) {
+            const auto i = static_cast<std::size_t>(std::countr_zero(chars));
+            const std::uint64_t at = base + i;
+            Run& run = wide_[at & 1];
+            if (!run.active || at != run.next) {
+                finish(run);
+                run.active = true;
+                run.start = at;
+            }
+            run.text.push_back(static_cast<char>(word[i]));
+            run.next = at + 2;
+        }
+        // A run whose next character should have been in this word has ended
+        for (Run& run : wide_) {
+            if (run.active && run.next < base + size) finish(run);
+        }
+    }
+}
+
+void StringsExtractor::emit() {
+    // Runs are complete in the order they start, but the ASCII and UTF-16
+    // scans of one block report them separately
+    std::stable_sort(found_.begin(), found_.end(), [](const Found& a, const Found& b) { return a.start < b.start; });
+    for (const Found& string : found_) {
+        char* out = sink_.reserve(formatter_.text_line_size(string.text.size()));
+        sink_.commit(formatter_.render_text_line(string.start, string.text, out));
+    }
+    found_.clear();
+}
+
+int StringsExtractor::run(int fd) {
+    // One byte is held back for the next block: a UTF-16 character needs the byte after it
+    std::vector<std::byte> buffer(1 + STRINGS_BLOCK_SIZE);
+
+    skip_to_start(fd, options_.start, options_.filename == "-", buffer);
+
+    std::size_t carry = 0;
+    std::uint64_t offset = options_.start;     // offset of buffer[0]
+    std::uint64_t remaining = options_.length; // 0 => unlimited
+    const bool limited = options_.length != 0;
+    int rc = 0;
+
+    for (bool eof = false; !eof;) {
+        std::size_t want = STRINGS_BLOCK_SIZE;
+        if (limited && remaining < want) want = static_cast<std::size_t>(remaining);
+        long got = want == 0 ? 0 : read_some(fd, buffer.data() + carry, want);
+        if (got < 0) {
+            std::cerr << "Error: failed to read input at offset " << offset + carry << ": "
+                      << std::strerror(errno) << "\n";
+            rc = 1;
+        }
+        eof = got <= 0;
+        const std::size_t filled = carry + (eof ? 0 : static_cast<std::size_t>(got));
+        if (limited && !eof) remaining -= static_cast<std::uint64_t>(got);
+
+        const std::size_t count = eof || !options_.utf16 ? filled : filled - 1;
+        scan(reinterpret_cast<const unsigned char*>(buffer.data()), count, filled, offset);
+        if (eof) {
+            finish(ascii_);
+            for (Run& run : wide_) finish(run);
+        }
+        emit();
+
+        carry = filled - count;
+        if (carry != 0) std::memmove(buffer.data(), buffer.data() + count, carry);
+        offset += count;
+    }
+
+    return rc;
+}
+
+} // namespace hexview
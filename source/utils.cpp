@@ -1,10 +1,21 @@
 #include "utils.hpp"
+#include "render_tables.hpp"
 #include <algorithm>
 #include <cctype>
+#include <cerrno>
 #include <iomanip>
+#include <iostream>
 #include <sstream>
 #include <stdexcept>
 
+#if defined(_WIN32) || defined(_WIN64)
+#  include <io.h>
+#else
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 namespace hexview {
 
 std::uint64_t parse_uint64(const std::string& s) {
@@ -31,10 +42,7 @@ std::string to_hex_uint(std::uint64_t value, std::size_t width, bool uppercase)
 }
 
 std::string to_hex_byte(unsigned int b, bool uppercase) {
-    std::ostringstream oss;
-    oss << std::hex << std::setw(2) << std::setfill('0')
-        << (uppercase ? std::uppercase : std::nouppercase) << (b & 0xFFu);
-    return oss.str();
+    return std::string(hex_pairs(uppercase) + 2 * (b & 0xFFu), 2);
 }
 
 bool is_printable_ascii(unsigned char ch) {
@@ -56,12 +64,173 @@ std::string escape_byte(unsigned char ch, bool show_escapes, bool ascii_dot_if_n
         case '\r': return std::string("\\r");
         case '\t': return std::string("\\t");
         default: {
-            std::ostringstream oss;
-            oss << "\\x" << std::hex << std::setw(2) << std::setfill('0')
-                << static_cast<int>(ch & 0xFF);
-            return oss.str();
+            std::string rep("\\x");
+            rep.append(hex_pairs(false) + 2 * ch, 2);
+            return rep;
+        }
+    }
+}
+
+std::uint64_t seekable_size(int fd) {
+#if defined(_WIN32) || defined(_WIN64)
+    (void)fd;
+    return 0;
+#else
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) return 0;
+    if (S_ISREG(st.st_mode)) return static_cast<std::uint64_t>(st.st_size);
+    if (S_ISBLK(st.st_mode)) {
+        off_t device_size = ::lseek(fd, 0, SEEK_END);
+        if (device_size > 0) return static_cast<std::uint64_t>(device_size);
+    }
+    // Pipes, character devices and files that report no size (procfs)
+    return 0;
+#endif
+}
+
+std::uint64_t range_end(std::uint64_t size, std::uint64_t start, std::uint64_t length) {
+    if (start >= size) return start;
+    if (length == 0 || length > size - start) return size;
+    return start + length;
+}
+
+long read_some(int fd, std::byte* data, std::size_t size) {
+#if defined(_WIN32) || defined(_WIN64)
+    return _read(fd, data, static_cast<unsigned int>(std::min<std::size_t>(size, 1u << 30)));
+#else
+    for (;;) {
+        ssize_t n = ::read(fd, data, size);
+        if (n >= 0 || errno != EINTR) return static_cast<long>(n);
+    }
+#endif
+}
+
+std::uint64_t skip_input(int fd, std::uint64_t count, std::span<std::byte> scratch) {
+    std::uint64_t skipped = 0;
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    // Regular files and block devices (including "< file" redirects) just move
+    const off_t position = ::lseek(fd, 0, SEEK_CUR);
+    if (position != -1) {
+        const std::uint64_t size = seekable_size(fd);
+        if (size != 0) {
+            const std::uint64_t here = static_cast<std::uint64_t>(position);
+            skipped = here < size ? std::min(count, size - here) : 0;
+            ::lseek(fd, static_cast<off_t>(here + skipped), SEEK_SET);
+            return skipped;
+        }
+    }
+
+#  if defined(__linux__)
+    // Pipes are drained in the kernel without copying into user space
+    int null_fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if (null_fd >= 0) {
+        bool at_end = false;
+        while (skipped < count) {
+            const std::size_t chunk = static_cast<std::size_t>(std::min<std::uint64_t>(count - skipped, 1u << 30));
+            ssize_t n = ::splice(fd, nullptr, null_fd, nullptr, chunk, SPLICE_F_MOVE);
+            if (n > 0) {
+                skipped += static_cast<std::uint64_t>(n);
+            } else if (n == 0) {
+                at_end = true;
+                break;
+            } else if (errno != EINTR) {
+                break; // not a pipe: fall back to reading
+            }
         }
+        ::close(null_fd);
+        if (at_end) return skipped;
+    }
+#  endif
+#endif
+
+    while (skipped < count) {
+        const std::size_t chunk = static_cast<std::size_t>(std::min<std::uint64_t>(count - skipped, scratch.size()));
+        long n = read_some(fd, scratch.data(), chunk);
+        if (n <= 0) break;
+        skipped += static_cast<std::uint64_t>(n);
+    }
+    return skipped;
+}
+
+std::size_t read_at(int fd, std::byte* data, std::size_t size, std::uint64_t offset, int& error) {
+#if defined(_WIN32) || defined(_WIN64)
+    (void)fd;
+    (void)data;
+    (void)size;
+    (void)offset;
+    error = ENOSYS;
+    return 0;
+#else
+    std::size_t got = 0;
+    while (got < size) {
+        ssize_t n = ::pread(fd, data + got, size - got, static_cast<off_t>(offset + got));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            error = errno;
+            break;
+        }
+        if (n == 0) break; // file shrank since it was sized
+        got += static_cast<std::size_t>(n);
+    }
+    return got;
+#endif
+}
+
+bool skip_to_start(int fd, std::uint64_t start, bool from_stdin, std::span<std::byte> scratch) {
+    if (start == 0) return true;
+    // Seekable inputs (including "< file" redirects) seek, pipes are drained
+    const bool skipped = skip_input(fd, start, scratch) == start;
+    if (!skipped && from_stdin) {
+        std::cerr << "Warning: could not skip to start offset; input too short.\n";
+    }
+    return skipped;
+}
+
+std::size_t read_full(int fd, std::byte* data, std::size_t size, int& error) {
+    std::size_t got = 0;
+    while (got < size) {
+        long n = read_some(fd, data + got, size - got);
+        if (n < 0) {
+            error = errno;
+            break;
+        }
+        if (n == 0) break;
+        got += static_cast<std::size_t>(n);
+    }
+    return got;
+}
+
+ByteRange find_hole_lines(int fd, std::uint64_t from, std::uint64_t end, std::size_t bytes_per_line) {
+    const ByteRange none{end, end};
+#if defined(_WIN32) || defined(_WIN64) || !defined(SEEK_HOLE)
+    (void)fd;
+    (void)from;
+    (void)bytes_per_line;
+    return none;
+#else
+    const std::uint64_t base = from;
+    while (from < end) {
+        const off_t hole = ::lseek(fd, static_cast<off_t>(from), SEEK_HOLE);
+        // Without hole support the file reports a single hole at its end
+        if (hole < 0 || static_cast<std::uint64_t>(hole) >= end) return none;
+
+        const off_t data = ::lseek(fd, hole, SEEK_DATA);
+        std::uint64_t hole_end = end;
+        if (data >= 0) {
+            hole_end = std::min(end, static_cast<std::uint64_t>(data));
+        } else if (errno != ENXIO) {
+            return none; // ENXIO: the hole runs to the end of the file
+        }
+
+        const std::uint64_t first = base + (static_cast<std::uint64_t>(hole) - base + bytes_per_line - 1)
+                                         / bytes_per_line * bytes_per_line;
+        const std::uint64_t last = base + (hole_end - base) / bytes_per_line * bytes_per_line;
+        if (last > first && last - first >= 2 * bytes_per_line) return ByteRange{first, last};
+        from = hole_end;
     }
+    return none;
+#endif
 }
 
-} // namespace hexview
\ No newline at end of file
+} // namespace hexview